@@ -470,5 +470,35 @@ namespace SEPOLIA4::BOOST_UNIT_TESTS
 			}
 		}
 
+		BOOST_AUTO_TEST_CASE(TEST_CBLAS_DGEMV_AX_USING_MATRIX_VIEW)
+		{
+			const int32_t NROWS = 6;
+			const int32_t NCOLS = 7;
+
+			Matrix<double> A(NROWS, NCOLS);
+			size_t idx = 0;
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					A(i, j) = static_cast<double>(++idx);
+				}
+			}
+
+			// the 3 x 4 block at (2, 1) goes to BLAS in place, through its leading dimension
+			const MatrixView<const double> block = A.Block(2, 1, 3, 4);
+			const Vector<double> x{ 1.0, 2.0, 3.0, 4.0 };
+			Vector<double> y(block.NRows());
+
+			cblas_dgemv(CblasRowMajor, CblasNoTrans, block.NRows(), block.NCols(), 1.0, block.Data(),
+					static_cast<int32_t>(block.LeadingDimension()), x.Data(), 1, 0.0, y.Data(), 1);
+
+			for (uint32_t i = 0; i < block.NRows(); i++)
+			{
+				BOOST_CHECK(y[i] == block.Row(i).Dot(x));
+			}
+			BOOST_CHECK(y[0] == 16.0 * 1.0 + 17.0 * 2.0 + 18.0 * 3.0 + 19.0 * 4.0);
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
 }
@@ -1,6 +1,16 @@
 #define BOOST_TEST_DYN_LINK
 
+#include "../Containers/Matrix/Matrix.h"
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+
+using namespace SEPOLIA4::CONTAINERS;
+
+extern "C"
+{
+	void dgesv_(const int* n, const int* nrhs, double* a, const int* lda, int* ipiv, double* b, const int* ldb, int* info);
+}
 
 namespace SEPOLIA4::BOOST_UNIT_TESTS
 {
@@ -11,5 +21,35 @@ namespace SEPOLIA4::BOOST_UNIT_TESTS
 		{
 		}
 
+		BOOST_AUTO_TEST_CASE(TEST2)
+		{
+			// column-major matrices go to LAPACK as they are: solve a * x = b in place
+			const ColumnMajorMatrix<double> a{{ 4, 1, 2 },
+											  { 1, 5, 3 },
+											  { 2, 3, 6 }};
+			const ColumnMajorMatrix<double> x{{ 1, -2 },
+											  { 2, 0 },
+											  { 3, 1 }};
+			ColumnMajorMatrix<double> b = MatMul(a, x);
+			ColumnMajorMatrix<double> lu = a;
+
+			const int n = static_cast<int>(a.NRows());
+			const int nrhs = static_cast<int>(b.NCols());
+			const int lda = static_cast<int>(lu.LeadingDimension());
+			const int ldb = static_cast<int>(b.LeadingDimension());
+			std::vector<int> ipiv(n);
+			int info = -1;
+			dgesv_(&n, &nrhs, lu.Data(), &lda, ipiv.data(), b.Data(), &ldb, &info);
+
+			BOOST_CHECK(info == 0);
+			for (uint32_t i = 0; i < x.NRows(); i++)
+			{
+				for (uint32_t j = 0; j < x.NCols(); j++)
+				{
+					BOOST_CHECK(std::abs(b.At(i, j) - x.At(i, j)) < 1.0e-12);
+				}
+			}
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
 }
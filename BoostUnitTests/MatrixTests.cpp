@@ -1,10 +1,22 @@
 #define BOOST_TEST_DYN_LINK
 
 #include "../Containers/Matrix/Matrix.h"
+#include "../Containers/Matrix/TiledMatrix.h"
+#include "../Containers/Vector/Vector.h"
+#include "../Utilities/CpuFeatures.h"
+#include "../Utilities/MappedFile.h"
+#include "../Utilities/Parallel.h"
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
 
 using namespace SEPOLIA4::CONTAINERS;
+using namespace SEPOLIA4::UTILITIES;
 
 namespace std
 {
@@ -720,6 +732,1318 @@ namespace SEPOLIA4::BOOST_UNIT_TESTS
 			BOOST_CHECK(m1 == m2);
 		}
 
+		BOOST_AUTO_TEST_CASE(TEST33)
+		{
+			Matrix<double> a(NROWS, NCOLS);
+			Matrix<double> b(NROWS, NCOLS);
+			Matrix<double> c(NROWS, NCOLS);
+			Matrix<double> d(NROWS, NCOLS);
+
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					a(i, j) = static_cast<double>(i + j);
+					b(i, j) = static_cast<double>(i + j + 1);
+					c(i, j) = static_cast<double>(i * j + 2);
+					d(i, j) = static_cast<double>(i + 3);
+				}
+			}
+
+			const Matrix<double> res = a + b * c - d;
+			BOOST_CHECK(res.NRows() == NROWS);
+			BOOST_CHECK(res.NCols() == NCOLS);
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					BOOST_CHECK(res.At(i, j) == a.At(i, j) + b.At(i, j) * c.At(i, j) - d.At(i, j));
+				}
+			}
+
+			Matrix<double> res2;
+			res2 = 2.0 * (a - 1.0) / (b + c) + -d;
+			BOOST_CHECK(res2.TotalElements() == a.TotalElements());
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					BOOST_CHECK(res2.At(i, j) == 2.0 * (a.At(i, j) - 1.0) / (b.At(i, j) + c.At(i, j)) + -d.At(i, j));
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST34)
+		{
+			Matrix<double> m1(NROWS, NCOLS);
+			Matrix<double> m2(NROWS, NCOLS);
+
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					m1(i, j) = static_cast<double>(i + j);
+					m2(i, j) = static_cast<double>(i);
+				}
+			}
+
+			// the target appears inside its own expression
+			m1 += m1 * m1 + m2;
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					BOOST_CHECK(m1.At(i, j) == static_cast<double>((i + j) + (i + j) * (i + j) + i));
+				}
+			}
+
+			// the target has a different shape than the expression
+			Matrix<double> m3(NCOLS, NROWS + 1);
+			m3 = m1 - m2;
+			BOOST_CHECK(m3.NRows() == NROWS);
+			BOOST_CHECK(m3.NCols() == NCOLS);
+
+			const auto expr = m1 - m2;
+			BOOST_CHECK(expr.At(1, 2) == m3.At(1, 2));
+			BOOST_CHECK(expr == m3);
+			BOOST_CHECK(m3 == expr);
+			BOOST_CHECK(expr != m1);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST35)
+		{
+			// the default allocator aligns the storage to a cache line
+			Matrix<double> m1(NROWS, NCOLS);
+			Matrix<float> m2(NROWS + 1, NCOLS + 3);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(m1.Data()) % CACHE_LINE_SIZE == 0);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(m2.Data()) % CACHE_LINE_SIZE == 0);
+			BOOST_CHECK(m1 == 0.0);
+			BOOST_CHECK(m2 == 0.0f);
+
+			// any standard allocator can be plugged in
+			Matrix<double, std::allocator<double>> m3(NROWS, NCOLS);
+			m3 = 3.0;
+			Matrix<double, std::allocator<double>> m4(m3 * m3 - 1.0);
+			BOOST_CHECK(m4 == 8.0);
+
+			Matrix<double, AlignedAllocator<double, 4096>> m5(NROWS, NCOLS);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(m5.Data()) % 4096 == 0);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST36)
+		{
+			Matrix<double> m1(NROWS, NCOLS, UNINITIALIZED);
+			BOOST_CHECK(m1.NRows() == NROWS);
+			BOOST_CHECK(m1.NCols() == NCOLS);
+			BOOST_CHECK(m1.IsAllocated());
+			m1 = 4.0;
+			BOOST_CHECK(m1 == 4.0);
+
+			Matrix<double> m2;
+			BOOST_CHECK(m2.AllocateUninitialized(NCOLS, NROWS));
+			BOOST_CHECK(m2.TotalElements() == static_cast<size_t>(NROWS) * NCOLS);
+			for (uint32_t i = 0; i < NCOLS; i++)
+			{
+				for (uint32_t j = 0; j < NROWS; j++)
+				{
+					m2(i, j) = static_cast<double>(i * j);
+				}
+			}
+			m1 = m2;
+			BOOST_CHECK(m1 == m2);
+			BOOST_CHECK(m1.NRows() == NCOLS);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST37)
+		{
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(3);
+
+			Matrix<double> m1(301, 777, PARALLEL_FIRST_TOUCH);
+			BOOST_CHECK(m1.NRows() == 301);
+			BOOST_CHECK(m1.NCols() == 777);
+			BOOST_CHECK(m1 == 0.0);
+
+			Matrix<float> m2;
+			BOOST_CHECK(m2.Allocate(NROWS, NCOLS, PARALLEL_FIRST_TOUCH));
+			BOOST_CHECK(m2 == 0.0f);
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST38)
+		{
+			// large matrices are evaluated on all the threads, with the SIMD kernels for single operations
+			const auto numThreads = GetNumThreads();
+			for (const size_t threads : { 1, 4 })
+			{
+				SetNumThreads(threads);
+
+				constexpr uint32_t BIG_NROWS = 513;
+				constexpr uint32_t BIG_NCOLS = 257;
+				Matrix<double> m1(BIG_NROWS, BIG_NCOLS);
+				Matrix<double> m2(BIG_NROWS, BIG_NCOLS);
+				for (uint32_t i = 0; i < BIG_NROWS; i++)
+				{
+					for (uint32_t j = 0; j < BIG_NCOLS; j++)
+					{
+						m1(i, j) = static_cast<double>(i) + j;
+						m2(i, j) = static_cast<double>(j) + 1;
+					}
+				}
+
+				Matrix<double> m3 = m1 + m2;
+				Matrix<double> m4 = 2.0 * m1 - m2 / 2.0;
+				m3 *= 2.0;
+				m3 -= m2;
+				m4 += m1 * m2;
+				bool ok = true;
+				for (uint32_t i = 0; i < BIG_NROWS; i++)
+				{
+					for (uint32_t j = 0; j < BIG_NCOLS; j++)
+					{
+						ok = ok && m3(i, j) == 2.0 * (m1(i, j) + m2(i, j)) - m2(i, j);
+						ok = ok && m4(i, j) == 2.0 * m1(i, j) - m2(i, j) / 2.0 + m1(i, j) * m2(i, j);
+					}
+				}
+				BOOST_CHECK(ok);
+			}
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST39)
+		{
+			// every execution policy gives the same results as the default operators
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+
+			constexpr uint32_t BIG_NROWS = 513;
+			constexpr uint32_t BIG_NCOLS = 257;
+			Matrix<double> m1(BIG_NROWS, BIG_NCOLS);
+			Matrix<double> m2(BIG_NROWS, BIG_NCOLS);
+			for (uint32_t i = 0; i < BIG_NROWS; i++)
+			{
+				for (uint32_t j = 0; j < BIG_NCOLS; j++)
+				{
+					m1(i, j) = static_cast<double>(i) - j;
+					m2(i, j) = static_cast<double>(j % 5) + 1.0;
+				}
+			}
+
+			Matrix<double> expected = 2.0 * m1 + m2;
+			expected *= m2;
+			expected -= 1.0;
+			expected /= 2.0;
+
+			double sumSquares = 0.0;
+			for (size_t i = 0; i < m1.TotalElements(); i++)
+			{
+				sumSquares += m1.Data()[i] * m1.Data()[i];
+			}
+
+			const auto check = [&](auto policy)
+			{
+				Matrix<double> m3;
+				m3.Assign(policy, 2.0 * m1 + m2);
+				m3.Multiply(policy, m2).Subtract(policy, 1.0).Divide(policy, 2.0);
+				BOOST_CHECK(m3 == expected);
+
+				Matrix<double> m4;
+				m4.Assign(policy, m1);
+				BOOST_CHECK(m4 == m1);
+				m4.Fill(policy, 3.0);
+				BOOST_CHECK(m4 == 3.0);
+				m4.Add(policy, m2).Subtract(policy, m2).Multiply(policy, 2.0).Add(policy, 1.0);
+				BOOST_CHECK(m4 == 7.0);
+
+				BOOST_CHECK(m1.Sum(policy) == m1.Sum());
+				BOOST_CHECK(m1.Sum(policy, Summation::PAIRWISE) == m1.Sum(Summation::PAIRWISE));
+				BOOST_CHECK(std::fabs(m1.FrobeniusNorm(policy) - std::sqrt(sumSquares)) <= 1.0e-12 * std::sqrt(sumSquares));
+				BOOST_CHECK(m1.Min(policy) == -256.0);
+				BOOST_CHECK(m1.Max(policy) == 512.0);
+				BOOST_CHECK(m1.MinMax(policy) == std::make_pair(-256.0, 512.0));
+			};
+			check(EXECUTION::SEQ);
+			check(EXECUTION::UNSEQ);
+			check(EXECUTION::PAR);
+			check(EXECUTION::PAR_UNSEQ);
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST40)
+		{
+			// rows, columns and the diagonal as views, without copies
+			Matrix<double> m1(NROWS, NCOLS);
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					m1(i, j) = 10.0 * i + j;
+				}
+			}
+
+			const auto row = m1.Row(2);
+			BOOST_CHECK(row.Size() == NCOLS);
+			BOOST_CHECK(row.IsContiguous());
+			BOOST_CHECK(row[4] == 24.0);
+			const auto col = m1.Col(3);
+			BOOST_CHECK(col.Size() == NROWS);
+			BOOST_CHECK(col.Stride() == NCOLS);
+			BOOST_CHECK(col[4] == 43.0);
+			const auto diagonal = m1.Diagonal();
+			BOOST_CHECK(diagonal.Size() == std::min(NROWS, NCOLS));
+			BOOST_CHECK(diagonal[3] == 33.0);
+
+			BOOST_CHECK(row.Sum() == 135.0);
+			BOOST_CHECK(col.Sum() == 115.0);
+			BOOST_CHECK(diagonal.Sum() == 110.0);
+			BOOST_CHECK(col.Dot(diagonal) == 3.0 * 0.0 + 13.0 * 11.0 + 23.0 * 22.0 + 33.0 * 33.0 + 43.0 * 44.0);
+			BOOST_CHECK(col.MinMax() == std::make_pair(3.0, 43.0));
+			BOOST_CHECK(m1.Row(1).ArgMax() == NCOLS - 1);
+
+			// writes through the views reach the matrix
+			m1.Col(0) = m1.Col(1) + m1.Col(2);
+			m1.Row(0) *= 2.0;
+			m1.Diagonal() = -1.0;
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					double expected = 10.0 * i + j;
+					if (j == 0) expected = 20.0 * i + 3.0;
+					if (i == 0) expected *= 2.0;
+					if (i == j) expected = -1.0;
+					BOOST_CHECK(m1(i, j) == expected);
+				}
+			}
+
+			// a row becomes a Vector, a Vector is written into a column
+			const Vector<double> v1 = m1.Row(4);
+			BOOST_CHECK(v1.Size() == NCOLS);
+			BOOST_CHECK(v1[1] == 41.0);
+			const Vector<double> v2{ 1.0, 2.0, 3.0, 4.0, 5.0 };
+			m1.Col(5) = v2;
+			m1.Col(5) += v2;
+			BOOST_CHECK(m1.Col(5) == 2.0 * v2);
+
+			const Matrix<double>& m2 = m1;
+			VectorView<const double> constRow = m2.Row(3);
+			BOOST_CHECK(constRow.Data() == m1.Data() + 3 * NCOLS);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST41)
+		{
+			// blocks of a matrix as views with a leading dimension, without copies
+			Matrix<double> m1(NROWS, NCOLS);
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					m1(i, j) = 10.0 * i + j;
+				}
+			}
+
+			MatrixView<double> block = m1.Block(1, 2, 3, 3);
+			BOOST_CHECK(block.NRows() == 3);
+			BOOST_CHECK(block.NCols() == 3);
+			BOOST_CHECK(block.LeadingDimension() == NCOLS);
+			BOOST_CHECK(!block.IsContiguous());
+			BOOST_CHECK(block(0, 0) == 12.0);
+			BOOST_CHECK(block.At(2, 1) == 33.0);
+			BOOST_CHECK(block[5] == 24.0);
+			BOOST_CHECK(block.Block(1, 1, 2, 2)(1, 1) == 34.0);
+			BOOST_CHECK(block.Col(2).Sum() == 14.0 + 24.0 + 34.0);
+
+			// every Matrix operation accepts a view
+			const Matrix<double> m2 = block;
+			BOOST_CHECK(m2.NRows() == 3);
+			BOOST_CHECK(m2 == block);
+			BOOST_CHECK(m2.At(2, 2) == 34.0);
+			Matrix<double> m3 = 2.0 * block + m2;
+			BOOST_CHECK(m3 == 3.0 * m2);
+			m3 -= block;
+			BOOST_CHECK(m3 == 2.0 * m2);
+			m3 = block - m1.Block(0, 0, 3, 3);
+			BOOST_CHECK(m3 == 12.0);
+
+			// reductions over a view with gaps between the rows
+			BOOST_CHECK(block.Sum() == m2.Sum());
+			BOOST_CHECK(block.Sum(Summation::KAHAN) == m2.Sum());
+			BOOST_CHECK(block.FrobeniusNorm() == m2.FrobeniusNorm());
+			BOOST_CHECK(block.MinMax() == std::make_pair(12.0, 34.0));
+			BOOST_CHECK(block.Min() == 12.0);
+			BOOST_CHECK(block.Max() == 34.0);
+
+			// writes through the view only touch the block
+			block *= 2.0;
+			block += m2;
+			block.Block(0, 0, 1, 3) = -1.0;
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					double expected = 10.0 * i + j;
+					if (i >= 1 && i <= 3 && j >= 2 && j <= 4) expected *= 3.0;
+					if (i == 1 && j >= 2 && j <= 4) expected = -1.0;
+					BOOST_CHECK(m1(i, j) == expected);
+				}
+			}
+			m1.Block(3, 0, 2, 2) = m1.Block(0, 4, 2, 2) + 1.0;
+			BOOST_CHECK(m1(3, 0) == 5.0);
+			BOOST_CHECK(m1(3, 1) == 6.0);
+			BOOST_CHECK(m1(4, 0) == 0.0);
+			BOOST_CHECK(m1(4, 1) == 16.0);
+
+			// large views under every policy
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+			constexpr uint32_t BIG_NROWS = 700;
+			constexpr uint32_t BIG_NCOLS = 600;
+			Matrix<double> m4(BIG_NROWS, BIG_NCOLS);
+			for (uint32_t i = 0; i < BIG_NROWS; i++)
+			{
+				for (uint32_t j = 0; j < BIG_NCOLS; j++)
+				{
+					m4(i, j) = static_cast<double>((i * 7 + j) % 100);
+				}
+			}
+			const Matrix<double> m5 = m4;
+			const auto check = [&](auto policy)
+			{
+				auto bigBlock = m4.Block(50, 30, 600, 500);
+				const auto source = m5.Block(100, 0, 600, 500);
+				bigBlock.Assign(policy, 2.0 * source).Add(policy, source).Subtract(policy, 1.0).Multiply(policy, source);
+				bool ok = true;
+				double sum = 0.0;
+				for (uint32_t i = 0; i < BIG_NROWS; i++)
+				{
+					for (uint32_t j = 0; j < BIG_NCOLS; j++)
+					{
+						double expected = m5.At(i, j);
+						if (i >= 50 && i < 650 && j >= 30 && j < 530)
+						{
+							const double s = m5.At(i + 50, j - 30);
+							expected = (3.0 * s - 1.0) * s;
+							sum += expected;
+						}
+						ok = ok && m4(i, j) == expected;
+					}
+				}
+				BOOST_CHECK(ok);
+				BOOST_CHECK(std::fabs(bigBlock.Sum(policy) - sum) <= 1.0e-12 * sum);
+				BOOST_CHECK(bigBlock.MinMax(policy) == std::make_pair(0.0, 99.0 * (3.0 * 99.0 - 1.0)));
+				const Matrix<double> copy(bigBlock);
+				BOOST_CHECK(copy == bigBlock);
+				m4.Assign(policy, m5);
+			};
+			check(EXECUTION::SEQ);
+			check(EXECUTION::UNSEQ);
+			check(EXECUTION::PAR);
+			check(EXECUTION::PAR_UNSEQ);
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST42)
+		{
+			// the blocked matrix product against the textbook triple loop, on every instruction set
+			const auto reference = [](const auto& a, const auto& b, auto alpha, auto beta, const auto& c)
+			{
+				auto res = c;
+				for (uint32_t i = 0; i < a.NRows(); i++)
+				{
+					for (uint32_t j = 0; j < b.NCols(); j++)
+					{
+						decltype(alpha) sum = 0;
+						for (uint32_t p = 0; p < a.NCols(); p++)
+						{
+							sum += a.At(i, p) * b.At(p, j);
+						}
+						res(i, j) = alpha * sum + beta * c.At(i, j);
+					}
+				}
+				return res;
+			};
+
+			const auto check = [&reference](auto zero, uint32_t m, uint32_t n, uint32_t k)
+			{
+				using T = decltype(zero);
+				Matrix<T> a(m, k);
+				Matrix<T> b(k, n);
+				Matrix<T> c(m, n);
+				for (uint32_t i = 0; i < m; i++)
+				{
+					for (uint32_t p = 0; p < k; p++)
+					{
+						a(i, p) = static_cast<T>((i * 3 + p) % 7) - T(3);
+					}
+				}
+				for (uint32_t p = 0; p < k; p++)
+				{
+					for (uint32_t j = 0; j < n; j++)
+					{
+						b(p, j) = static_cast<T>((p + 5 * j) % 11) - T(5);
+					}
+				}
+				for (uint32_t i = 0; i < m; i++)
+				{
+					for (uint32_t j = 0; j < n; j++)
+					{
+						c(i, j) = static_cast<T>((i + j) % 3);
+					}
+				}
+
+				// small integers: every order of the additions gives the exact result
+				BOOST_CHECK(MatMul(a, b) == reference(a, b, T(1), T(0), c));
+				BOOST_CHECK(MatMul(EXECUTION::UNSEQ, a, b) == reference(a, b, T(1), T(0), c));
+				const auto expected = reference(a, b, T(2), T(-1), c);
+				auto c2 = c;
+				Gemm<T>(T(2), a, b, T(-1), c);
+				BOOST_CHECK(c == expected);
+
+				// UNSEQ always runs the native kernels, PAR_UNSEQ large products through BLAS
+				Gemm<T>(EXECUTION::UNSEQ, T(2), a, b, T(-1), c2);
+				BOOST_CHECK(c2 == expected);
+			};
+
+			const auto detected = CpuFeatures::GetDetectedSimdLevel();
+			for (const auto level : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+			{
+				if (level > detected) continue;
+				CpuFeatures::SetSimdLevel(level);
+				for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 1, 1, 1 }, { 5, 7, 3 }, { 17, 33, 9 },
+																			{ 64, 48, 96 }, { 130, 70, 600 }, { 9, 301, 1 } })
+				{
+					check(0.0, dims[0], dims[1], dims[2]);
+					check(0.0f, dims[0], dims[1], dims[2]);
+				}
+			}
+			CpuFeatures::SetSimdLevel(detected);
+			check(0, 13, 11, 7);
+
+			// blocks of larger matrices go in place through their leading dimension
+			Matrix<double> m1(40, 50);
+			Matrix<double> m2(60, 30);
+			Matrix<double> m3(35, 45);
+			for (size_t i = 0; i < m1.TotalElements(); i++)
+			{
+				m1.Data()[i] = static_cast<double>(i % 13) - 6.0;
+			}
+			for (size_t i = 0; i < m2.TotalElements(); i++)
+			{
+				m2.Data()[i] = static_cast<double>(i % 9) - 4.0;
+			}
+			m3 = 1.0;
+			const Matrix<double> a = m1.Block(3, 5, 20, 25);
+			const Matrix<double> b = m2.Block(10, 2, 25, 17);
+			Gemm(1.0, m1.Block(3, 5, 20, 25), m2.Block(10, 2, 25, 17), 0.0, m3.Block(4, 6, 20, 17));
+			const Matrix<double> block = m3.Block(4, 6, 20, 17);
+			BOOST_CHECK(block == MatMul(a, b));
+			BOOST_CHECK(m3.Sum() == static_cast<double>(m3.TotalElements() - block.TotalElements()) + block.Sum());
+
+			// the empty product only scales
+			Matrix<double> m4(3, 4);
+			m4 = 2.0;
+			Gemm(1.0, Matrix<double>(3, 0), Matrix<double>(0, 4), 3.0, m4);
+			BOOST_CHECK(m4 == 6.0);
+
+			BOOST_CHECK_THROW(MatMul(m1, m1), std::invalid_argument);
+			BOOST_CHECK_THROW(Gemm(1.0, m1, m2, 0.0, m3), std::invalid_argument);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST43)
+		{
+			// the BLAS backend of PAR_UNSEQ against the native kernels of UNSEQ, above the size thresholds
+			Matrix<double> m1(200, 180);
+			Matrix<double> m2(170, 210);
+			for (size_t i = 0; i < m1.TotalElements(); i++)
+			{
+				m1.Data()[i] = static_cast<double>(i % 13) - 6.0;
+			}
+			for (size_t i = 0; i < m2.TotalElements(); i++)
+			{
+				m2.Data()[i] = static_cast<double>(i % 7) - 3.0;
+			}
+
+			// blocks with leading dimensions: (150 x 120) * (120 x 100) into a block of c
+			Matrix<double> c1(160, 110);
+			c1 = 1.0;
+			Matrix<double> c2(c1);
+			Gemm(2.0, m1.Block(10, 20, 150, 120), m2.Block(5, 30, 120, 100), -1.0, c1.Block(3, 4, 150, 100));
+			Gemm(EXECUTION::UNSEQ, 2.0, m1.Block(10, 20, 150, 120), m2.Block(5, 30, 120, 100), -1.0,
+					c2.Block(3, 4, 150, 100));
+			BOOST_CHECK(c1 == c2);
+			BOOST_CHECK(c1(0, 0) == 1.0);
+			BOOST_CHECK(c1(159, 109) == 1.0);
+
+			// scaling
+			Matrix<float> m3(200, 200);
+			m3 = 1.5f;
+			Matrix<float> m4(m3);
+			m3 *= 4.0f;
+			m4.Multiply(EXECUTION::UNSEQ, 4.0f);
+			BOOST_CHECK(m3 == m4);
+			BOOST_CHECK(m3 == 6.0f);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST44)
+		{
+			// matrix-vector products against the textbook loops, on every instruction set and policy
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+
+			const auto check = [](auto policy, auto zero, uint32_t m, uint32_t n)
+			{
+				using T = decltype(zero);
+				Matrix<T> a(m + 3, n + 2);
+				for (size_t i = 0; i < a.TotalElements(); i++)
+				{
+					a.Data()[i] = static_cast<T>(i % 7) - T(3);
+				}
+				const auto block = a.Block(1, 2, m, n);
+
+				for (const auto transpose : { Transpose::NO, Transpose::YES })
+				{
+					const size_t nx = transpose == Transpose::NO ? n : m;
+					const size_t ny = transpose == Transpose::NO ? m : n;
+					Vector<T> x(2 * nx + 1);
+					Vector<T> y(2 * ny + 1);
+					for (size_t i = 0; i < x.Size(); i++)
+					{
+						x[i] = static_cast<T>(i % 5) - T(2);
+					}
+					for (size_t i = 0; i < y.Size(); i++)
+					{
+						y[i] = static_cast<T>(i % 3);
+					}
+
+					// small integers: every order of the additions gives the exact result
+					const auto reference = [&](const auto& xs, const auto& ys, T alpha, T beta)
+					{
+						std::vector<T> res(ny);
+						for (size_t i = 0; i < ny; i++)
+						{
+							T sum = 0;
+							for (size_t p = 0; p < nx; p++)
+							{
+								sum += (transpose == Transpose::NO ? block.At(i, p) : block.At(p, i)) * xs[p];
+							}
+							res[i] = alpha * sum + beta * ys[i];
+						}
+						return res;
+					};
+
+					// contiguous x and y
+					Vector<T> y1(ny);
+					std::copy_n(y.Data(), ny, y1.Data());
+					const auto expected1 = reference(x, y1, T(2), T(-1));
+					Gemv<T>(policy, transpose, T(2), block, x.Slice(0, nx), T(-1), y1);
+					BOOST_CHECK(std::equal(expected1.begin(), expected1.end(), y1.Data()));
+
+					// strided x and y
+					const auto xs = x.Slice(1, nx, 2);
+					const auto expected2 = reference(xs, y.Slice(0, ny, 2), T(3), T(2));
+					Gemv<T>(policy, transpose, T(3), block, xs, T(2), y.Slice(0, ny, 2));
+					for (size_t i = 0; i < ny; i++)
+					{
+						BOOST_CHECK(y[2 * i] == expected2[i]);
+						BOOST_CHECK(y[2 * i + 1] == static_cast<T>((2 * i + 1) % 3));
+					}
+
+					// with beta = 0, y is not read
+					if constexpr (std::is_floating_point_v<T>)
+					{
+						Vector<T> y3(ny);
+						y3 = std::numeric_limits<T>::quiet_NaN();
+						Gemv<T>(policy, transpose, T(1), block, x.Slice(0, nx), T(0), y3);
+						const auto expected3 = reference(x, y1, T(1), T(0));
+						BOOST_CHECK(std::equal(expected3.begin(), expected3.end(), y3.Data()));
+					}
+				}
+			};
+
+			const auto detected = CpuFeatures::GetDetectedSimdLevel();
+			for (const auto level : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+			{
+				if (level > detected) continue;
+				CpuFeatures::SetSimdLevel(level);
+				for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 1, 1 }, { 7, 5 }, { 33, 17 }, { 4, 64 },
+																			{ 301, 9 }, { 0, 5 }, { 5, 0 }, { 700, 600 } })
+				{
+					check(EXECUTION::UNSEQ, 0.0, dims[0], dims[1]);
+					check(EXECUTION::UNSEQ, 0.0f, dims[0], dims[1]);
+				}
+			}
+			CpuFeatures::SetSimdLevel(detected);
+
+			// parallel and BLAS paths
+			for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 7, 5 }, { 700, 600 }, { 130, 2050 } })
+			{
+				check(EXECUTION::SEQ, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0.0f, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0, dims[0], dims[1]);
+			}
+
+			// the policy-free overloads and the dimension checks
+			Matrix<double> m1(3, 2);
+			m1 = 1.0;
+			Vector<double> x1(2);
+			x1 = 1.0;
+			Vector<double> y1(3);
+			Gemv(2.0, m1, x1, 0.0, y1);
+			BOOST_CHECK(y1 == 4.0);
+			Gemv(Transpose::YES, 1.0, m1, y1, 0.0, x1);
+			BOOST_CHECK(x1 == 12.0);
+			BOOST_CHECK_THROW(Gemv(1.0, m1, y1, 0.0, y1), std::invalid_argument);
+			BOOST_CHECK_THROW(Gemv(Transpose::YES, 1.0, m1, x1, 0.0, y1), std::invalid_argument);
+
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST45)
+		{
+			// the threaded product splits C into tiles but adds every element up in the same order:
+			// the results equal the ones of the calling thread alone, to the last bit
+			const auto numThreads = GetNumThreads();
+			KERNELS::SetBlasEnabled(false);
+
+			const auto check = [](auto zero, uint32_t m, uint32_t n, uint32_t k)
+			{
+				using T = decltype(zero);
+				Matrix<T> a(m, k);
+				Matrix<T> b(k, n);
+				Matrix<T> c(m, n);
+				for (size_t i = 0; i < a.TotalElements(); i++)
+				{
+					a.Data()[i] = static_cast<T>(std::sin(0.1 * static_cast<double>(i)));
+				}
+				for (size_t i = 0; i < b.TotalElements(); i++)
+				{
+					b.Data()[i] = static_cast<T>(std::cos(0.3 * static_cast<double>(i)));
+				}
+				for (size_t i = 0; i < c.TotalElements(); i++)
+				{
+					c.Data()[i] = static_cast<T>(i % 5);
+				}
+
+				auto expected = c;
+				Gemm<T>(EXECUTION::UNSEQ, T(1.5), a, b, T(0.5), expected);
+				auto c1 = c;
+				Gemm<T>(EXECUTION::PAR_UNSEQ, T(1.5), a, b, T(0.5), c1);
+				BOOST_CHECK(c1 == expected);
+
+				auto scalar = c;
+				Gemm<T>(EXECUTION::SEQ, T(1.5), a, b, T(0.5), scalar);
+				auto c2 = c;
+				Gemm<T>(EXECUTION::PAR, T(1.5), a, b, T(0.5), c2);
+				BOOST_CHECK(c2 == scalar);
+			};
+
+			for (const size_t threads : { 2, 3, 4 })
+			{
+				SetNumThreads(threads);
+				// one block of rows split in columns, several blocks of rows, thin and deep products
+				for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 300, 260, 300 }, { 1100, 130, 40 },
+																			{ 1100, 5, 300 }, { 20, 900, 150 } })
+				{
+					check(0.0, dims[0], dims[1], dims[2]);
+					check(0.0f, dims[0], dims[1], dims[2]);
+				}
+			}
+			SetNumThreads(4);
+			check(0, 130, 140, 150);
+
+			KERNELS::SetBlasEnabled(true);
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST46)
+		{
+			// transposes out of place and in place, on every instruction set
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(3);
+
+			const auto check = [](auto policy, auto zero, uint32_t m, uint32_t n)
+			{
+				using T = decltype(zero);
+				Matrix<T> a(m, n);
+				for (size_t i = 0; i < a.TotalElements(); i++)
+				{
+					a.Data()[i] = static_cast<T>(i % 1001);
+				}
+				const auto isTransposeOfA = [&a, m, n](const Matrix<T>& b)
+				{
+					if (b.NRows() != n || b.NCols() != m) return false;
+					for (uint32_t i = 0; i < m; i++)
+					{
+						for (uint32_t j = 0; j < n; j++)
+						{
+							if (b.At(j, i) != a.At(i, j)) return false;
+						}
+					}
+					return true;
+				};
+
+				BOOST_CHECK(isTransposeOfA(a.Transposed(policy)));
+				auto b = a;
+				b.TransposeInPlace(policy);
+				BOOST_CHECK(isTransposeOfA(b));
+				b.TransposeInPlace(policy);
+				BOOST_CHECK(b == a);
+
+				// into a block of a larger matrix
+				Matrix<T> c(n + 3, m + 2);
+				c = T(-1);
+				CopyTransposed<T>(policy, a, c.Block(2, 1, n, m));
+				BOOST_CHECK(isTransposeOfA(Matrix<T>(c.Block(2, 1, n, m))));
+				BOOST_CHECK(c(0, 0) == T(-1));
+				BOOST_CHECK(c(n + 2, m + 1) == T(-1));
+			};
+
+			const auto detected = CpuFeatures::GetDetectedSimdLevel();
+			for (const auto level : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+			{
+				if (level > detected) continue;
+				CpuFeatures::SetSimdLevel(level);
+				for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 1, 1 }, { 1, 9 }, { 9, 1 }, { 8, 8 }, { 16, 16 },
+																			{ 7, 13 }, { 33, 65 }, { 100, 100 }, { 130, 47 } })
+				{
+					check(EXECUTION::UNSEQ, 0.0, dims[0], dims[1]);
+					check(EXECUTION::UNSEQ, 0.0f, dims[0], dims[1]);
+				}
+			}
+			CpuFeatures::SetSimdLevel(detected);
+
+			// parallel splits of large matrices
+			for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 0, 0 }, { 300, 300 }, { 517, 301 }, { 64, 2000 } })
+			{
+				check(EXECUTION::SEQ, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0.0, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0.0f, dims[0], dims[1]);
+				check(EXECUTION::PAR_UNSEQ, 0, dims[0], dims[1]);
+			}
+
+			Matrix<double> m1(3, 2);
+			Matrix<double> m2(3, 2);
+			BOOST_CHECK_THROW(CopyTransposed<double>(m1, m2), std::invalid_argument);
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST47)
+		{
+			// column-major storage: layout, views, conversions and products against row-major
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(3);
+
+			ColumnMajorMatrix<double> c{{ 1, 2, 3 },
+										{ 4, 5, 6 }};
+			BOOST_CHECK(c.NRows() == 2 && c.NCols() == 3 && c.LeadingDimension() == 2);
+			BOOST_CHECK(c.Data()[0] == 1 && c.Data()[1] == 4 && c.Data()[2] == 2 && c.Data()[5] == 6);
+			BOOST_CHECK(c.At(1, 2) == 6);
+			c(0, 2) = 7;
+			BOOST_CHECK(c.Data()[4] == 7);
+			BOOST_CHECK(c.Row(1).Stride() == 2 && c.Row(1)[2] == 6);
+			BOOST_CHECK(c.Col(2).Stride() == 1 && c.Col(2)[0] == 7);
+			BOOST_CHECK(c.Diagonal()[1] == 5);
+			BOOST_CHECK(c.Block(0, 1, 2, 2).At(1, 0) == 5);
+
+			const Matrix<double> r{{ 1, 2, 7 },
+								   { 4, 5, 6 }};
+			BOOST_CHECK(c == r);
+			BOOST_CHECK(r == c);
+			BOOST_CHECK(c + r == r * 2.0);
+			BOOST_CHECK(Matrix<double>(c * r - 1.0) == r * r - 1.0);
+			BOOST_CHECK(ColumnMajorMatrix<double>(-r) == -c);
+			c += r;
+			BOOST_CHECK(c == r * 2.0);
+			c -= r;
+			BOOST_CHECK(c.Sum() == r.Sum());
+
+			for (const auto& dims : std::vector<std::vector<uint32_t>>{ { 1, 1 }, { 7, 13 }, { 64, 64 }, { 130, 47 }, { 300, 517 } })
+			{
+				const uint32_t m = dims[0];
+				const uint32_t n = dims[1];
+				Matrix<double> a(m, n);
+				for (size_t i = 0; i < a.TotalElements(); i++)
+				{
+					a.Data()[i] = static_cast<double>(i % 1001);
+				}
+
+				// copies transpose the storage, moves transpose it in place
+				ColumnMajorMatrix<double> ac = a;
+				BOOST_CHECK(ac == a);
+				BOOST_CHECK(Matrix<double>(ac) == a);
+				Matrix<double> moved = a;
+				ColumnMajorMatrix<double> movedAc(std::move(moved));
+				BOOST_CHECK(moved.IsDeallocated());
+				BOOST_CHECK(movedAc == a);
+				moved = std::move(movedAc);
+				BOOST_CHECK(moved == a);
+				BOOST_CHECK(movedAc.IsDeallocated());
+				ac.Assign(EXECUTION::SEQ, a.Block(0, 0, m, n));
+				BOOST_CHECK(ac == a);
+
+				const auto at = ac.Transposed();
+				BOOST_CHECK(at == a.Transposed());
+				ac.TransposeInPlace();
+				BOOST_CHECK(ac == at);
+				ac.TransposeInPlace(EXECUTION::SEQ);
+				BOOST_CHECK(ac == a);
+
+				ColumnMajorMatrix<double> bt(n, m);
+				CopyTransposed<double>(ac, bt);
+				BOOST_CHECK(bt == at);
+
+				// products of column-major matrices match the row-major ones bit for bit
+				Matrix<double> b(n, 5);
+				for (size_t i = 0; i < b.TotalElements(); i++)
+				{
+					b.Data()[i] = static_cast<double>(i % 7) - 3.0;
+				}
+				const ColumnMajorMatrix<double> bc = b;
+				BOOST_CHECK(MatMul(EXECUTION::SEQ, ac, bc) == MatMul(EXECUTION::SEQ, a, b));
+				BOOST_CHECK(MatMul(ac, bc) == MatMul(a, b));
+
+				Vector<double> x(n);
+				Vector<double> xt(m);
+				for (uint32_t i = 0; i < n; i++) x[i] = static_cast<double>(i % 5);
+				for (uint32_t i = 0; i < m; i++) xt[i] = static_cast<double>(i % 3);
+				Vector<double> y(m);
+				Vector<double> yc(m);
+				Gemv<double>(EXECUTION::SEQ, Transpose::NO, 1.0, a, x, 0.0, y);
+				Gemv<double>(EXECUTION::SEQ, Transpose::NO, 1.0, ac, x, 0.0, yc);
+				BOOST_CHECK(yc == y);
+				Vector<double> z(n);
+				Vector<double> zc(n);
+				Gemv<double>(Transpose::YES, 1.0, a, xt, 0.0, z);
+				Gemv<double>(Transpose::YES, 1.0, ac, xt, 0.0, zc);
+				BOOST_CHECK(zc == z);
+			}
+
+			// a column-major Gemm into a block of a larger matrix
+			ColumnMajorMatrix<float> a{{ 1, 2 },
+									   { 3, 4 }};
+			ColumnMajorMatrix<float> big(4, 4);
+			big = -1.0f;
+			Gemm<float>(1.0f, a, a, 0.0f, big.Block(1, 1, 2, 2));
+			BOOST_CHECK(big.At(1, 1) == 7.0f && big.At(1, 2) == 10.0f && big.At(2, 1) == 15.0f && big.At(2, 2) == 22.0f);
+			BOOST_CHECK(big.At(0, 0) == -1.0f && big.At(3, 3) == -1.0f && big.At(1, 3) == -1.0f);
+			BOOST_CHECK_THROW(Gemm<float>(1.0f, a, big, 0.0f, big), std::invalid_argument);
+
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST48)
+		{
+			// more than 2^32 elements: only the touched pages of the mapped storage are committed
+			constexpr MatrixIndex N = 65537;
+			constexpr size_t TOTAL = size_t(N) * N;
+			static_assert(TOTAL > (size_t(1) << 32));
+			{
+				Matrix<uint8_t> m(N, N, UNINITIALIZED);
+				BOOST_CHECK(m.IsAllocated());
+				BOOST_CHECK(m.TotalElements() == TOTAL);
+				m(N - 1, N - 1) = 7;
+				BOOST_CHECK(&m(N - 1, N - 1) - m.Data() == static_cast<ptrdiff_t>(TOTAL - 1));
+				BOOST_CHECK(m[TOTAL - 1] == 7);
+				BOOST_CHECK(m.Row(N - 1).Data() == m.Data() + TOTAL - N);
+				BOOST_CHECK(m.Col(N - 1)[N - 1] == 7);
+				BOOST_CHECK(m.Diagonal().Size() == N && m.Diagonal()[N - 1] == 7);
+
+				auto corner = m.Block(N - 5, N - 5, 5, 5);
+				corner = uint8_t(1);
+				corner += corner * uint8_t(2);
+				BOOST_CHECK(corner.Sum() == 75);
+				BOOST_CHECK(m.At(N - 1, N - 1) == 3);
+				BOOST_CHECK(m[TOTAL - 1 - 4 * N] == 3);
+			}
+			{
+				ColumnMajorMatrix<uint8_t> c(N, N, UNINITIALIZED);
+				c(0, N - 1) = 5;
+				BOOST_CHECK(c[TOTAL - N] == 5);
+				BOOST_CHECK(c.Row(0).Stride() == N && c.Row(0)[N - 1] == 5);
+			}
+#ifdef SEPOLIA4_LARGE_MATRICES
+			{
+				// a dimension beyond 32 bits
+				constexpr MatrixIndex ROWS = (MatrixIndex(1) << 32) + 3;
+				Matrix<uint8_t> tall(ROWS, 1, UNINITIALIZED);
+				BOOST_CHECK(tall.NRows() == ROWS && tall.TotalElements() == ROWS);
+				tall(ROWS - 1, 0) = 9;
+				BOOST_CHECK(tall.Data()[ROWS - 1] == 9);
+				BOOST_CHECK(tall.Col(0).Size() == ROWS && tall.Col(0)[ROWS - 1] == 9);
+				BOOST_CHECK(tall.Block(ROWS - 2, 0, 2, 1).At(1, 0) == 9);
+			}
+#endif
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST49)
+		{
+			// padded rows and columns: every operation matches the unpadded matrix
+			static_assert(PaddedLeadingDimension<double>(1024) == 1032);
+			static_assert(PaddedLeadingDimension<float>(1000) == 1008);
+			static_assert(PaddedLeadingDimension<double>(8) == 8);
+			static_assert(PaddedLeadingDimension<double>(9) == 24);
+			static_assert(PaddedLeadingDimension<double>(0) == 0);
+
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(3);
+
+			const auto check = [](auto zero, MatrixIndex m, MatrixIndex n)
+			{
+				using T = decltype(zero);
+				Matrix<T> a(m, n);
+				Matrix<T> b(m, n);
+				for (MatrixIndex i = 0; i < m; i++)
+				{
+					for (MatrixIndex j = 0; j < n; j++)
+					{
+						a(i, j) = static_cast<T>((i * n + j) % 1001);
+						b(i, j) = static_cast<T>((i + 2 * j) % 13 + 1);
+					}
+				}
+
+				Matrix<T> ap(m, n, PADDED);
+				ap = a;
+				Matrix<T> bp(m, n, PADDED, UNINITIALIZED);
+				bp.Assign(EXECUTION::SEQ, b);
+				BOOST_CHECK(ap.IsPadded() && ap.LeadingDimension() == PaddedLeadingDimension<T>(n));
+				BOOST_CHECK(reinterpret_cast<uintptr_t>(&ap(m - 1, 0)) % CACHE_LINE_SIZE == 0);
+				BOOST_CHECK(ap == a && bp == b);
+				BOOST_CHECK(ap[m * n - 1] == a[m * n - 1]);
+
+				// expressions, with padded and unpadded operands
+				for (const auto policy : { 0, 1 })
+				{
+					Matrix<T> c(m, n, PADDED);
+					if (policy == 0) c.Assign(EXECUTION::SEQ, ap * bp + ap);
+					else c.Assign(EXECUTION::PAR_UNSEQ, ap * bp + ap);
+					BOOST_CHECK(c == a * b + a);
+					c = ap + bp;
+					BOOST_CHECK(c == a + b);
+					c = ap + b;
+					BOOST_CHECK(c == a + b);
+					c = ap * T(3);
+					BOOST_CHECK(c == a * T(3));
+					c = T(2) - bp;
+					BOOST_CHECK(c == T(2) - b);
+					Matrix<T> d = a;
+					d = bp - a;
+					BOOST_CHECK(!d.IsPadded() && d == b - a);
+				}
+
+				Matrix<T> c = ap;
+				BOOST_CHECK(c.IsPadded() && c == a);
+				c += bp;
+				c -= b;
+				c *= bp;
+				c /= b;
+				c *= T(2);
+				c += T(1);
+				++c;
+				--c;
+				BOOST_CHECK(c == a * T(2) + T(1));
+				c = T(5);
+				BOOST_CHECK(c == T(5) && c.Sum() == T(5) * static_cast<T>(m * n));
+
+				BOOST_CHECK(std::abs(ap.Sum() - a.Sum()) <= std::abs(a.Sum()) * T(1e-5));
+				BOOST_CHECK(ap.Min() == a.Min() && ap.Max() == a.Max() && ap.MinMax() == a.MinMax());
+				BOOST_CHECK(std::abs(ap.FrobeniusNorm() - a.FrobeniusNorm()) <= a.FrobeniusNorm() * T(1e-5));
+				BOOST_CHECK(ap.Row(m - 1) == a.Row(m - 1) && ap.Col(n - 1) == a.Col(n - 1));
+				BOOST_CHECK(ap.Diagonal() == a.Diagonal());
+
+				// reallocation keeps the padding
+				Matrix<T> grown(1, 1, PADDED);
+				grown = ap * bp;
+				BOOST_CHECK(grown.IsPadded() && grown.LeadingDimension() == ap.LeadingDimension() && grown == a * b);
+
+				// transposes, order conversions and products
+				BOOST_CHECK(ap.Transposed() == a.Transposed());
+				Matrix<T> at = ap;
+				at.TransposeInPlace();
+				BOOST_CHECK(at.IsPadded() && at == a.Transposed());
+				at.TransposeInPlace(EXECUTION::SEQ);
+				BOOST_CHECK(at == a);
+				ColumnMajorMatrix<T> ac(m, n, PADDED);
+				ac = ap;
+				BOOST_CHECK(ac == a && ac.LeadingDimension() == PaddedLeadingDimension<T>(m));
+				BOOST_CHECK(Matrix<T>(std::move(ac)) == a);
+
+				Matrix<T> bn(n, 7);
+				Matrix<T> bnp(n, 7, PADDED);
+				for (MatrixIndex i = 0; i < n; i++)
+				{
+					for (MatrixIndex j = 0; j < 7; j++)
+					{
+						bn(i, j) = static_cast<T>((i + j) % 5);
+					}
+				}
+				bnp = bn;
+				BOOST_CHECK(MatMul(EXECUTION::SEQ, ap, bnp) == MatMul(EXECUTION::SEQ, a, bn));
+				Vector<T> x(n);
+				x = T(1);
+				Vector<T> y(m);
+				Vector<T> yp(m);
+				Gemv<T>(EXECUTION::SEQ, Transpose::NO, T(1), a, x, T(0), y);
+				Gemv<T>(EXECUTION::SEQ, Transpose::NO, T(1), ap, x, T(0), yp);
+				BOOST_CHECK(yp == y);
+			};
+
+			for (const auto& dims : std::vector<std::vector<MatrixIndex>>{ { 1, 1 }, { 1, 9 }, { 9, 1 }, { 8, 8 }, { 7, 13 },
+																		   { 64, 64 }, { 130, 47 }, { 256, 256 } })
+			{
+				check(0.0, dims[0], dims[1]);
+				check(0.0f, dims[0], dims[1]);
+			}
+			check(0, 33, 17);
+
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST50)
+		{
+			// tile-contiguous storage: round trips, element access, tiles and blocked products over tiles
+			static_assert(KERNELS::TileCount<8>(17) == 3 && KERNELS::TileCount<8>(16) == 2);
+
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(3);
+
+			for (const auto& [m, n] : std::vector<std::pair<MatrixIndex, MatrixIndex>>{{ 1, 1 }, { 8, 8 }, { 17, 5 }, { 33, 70 }})
+			{
+				Matrix<double> a(m, n);
+				for (MatrixIndex i = 0; i < m; i++)
+				{
+					for (MatrixIndex j = 0; j < n; j++)
+					{
+						a(i, j) = static_cast<double>(i * n + j);
+					}
+				}
+
+				TiledMatrix<double, 8> t(a);
+				BOOST_CHECK(t.NRows() == m && t.NCols() == n);
+				BOOST_CHECK(t.TileRows() == KERNELS::TileCount<8>(m) && t.TileCols() == KERNELS::TileCount<8>(n));
+				BOOST_CHECK(t.StorageSize() == static_cast<size_t>(t.TileRows()) * t.TileCols() * 64);
+				BOOST_CHECK(t == a && t[m * n - 1] == a[m * n - 1]);
+				BOOST_CHECK(t.At(m - 1, n - 1) == a.At(m - 1, n - 1));
+
+				// the elements of a tile are contiguous, the tiles of a tile row next to each other
+				if (n > 8) BOOST_CHECK(&t.At(0, 8) == t.Data() + 64);
+				BOOST_CHECK(&t.At(1, 0) == t.Data() + 8);
+
+				// edge tiles are clipped
+				const auto& ct = t;
+				const auto edge = ct.Tile(t.TileRows() - 1, t.TileCols() - 1);
+				BOOST_CHECK(edge.NRows() == m - (t.TileRows() - 1) * 8 && edge.NCols() == n - (t.TileCols() - 1) * 8);
+				BOOST_CHECK(edge == a.Block((t.TileRows() - 1) * 8, (t.TileCols() - 1) * 8, edge.NRows(), edge.NCols()));
+
+				// round trips, under every policy
+				Matrix<double> b(m, n);
+				t.CopyTo(EXECUTION::SEQ, b);
+				BOOST_CHECK(b == a);
+				b = 0.0;
+				t.CopyTo(b);
+				BOOST_CHECK(b == a);
+				BOOST_CHECK(t.ToMatrix(EXECUTION::PAR) == a && t.ToMatrix() == a);
+				const Matrix<double> c = t;
+				BOOST_CHECK(c == a);
+				BOOST_CHECK(Matrix<double>(t + a) == a * 2.0);
+
+				// writes through a tile view and through operator()
+				t.Tile(0, 0)(0, 0) = -1.0;
+				t(m - 1, n - 1) = -2.0;
+				b = a;
+				b(0, 0) = -1.0;
+				b(m - 1, n - 1) = -2.0;
+				BOOST_CHECK(t.ToMatrix() == b);
+
+				TiledMatrix<double, 8> u;
+				u.Assign(EXECUTION::UNSEQ, b.Block(0, 0, m, n));
+				BOOST_CHECK(u == b);
+				u = 3.0;
+				BOOST_CHECK(u == 3.0);
+			}
+
+			// c = a * b, one tile product at a time
+			const MatrixIndex m = 37;
+			const MatrixIndex k = 20;
+			const MatrixIndex n = 45;
+			Matrix<double> a(m, k);
+			Matrix<double> b(k, n);
+			for (MatrixIndex i = 0; i < m; i++)
+			{
+				for (MatrixIndex j = 0; j < k; j++)
+				{
+					a(i, j) = static_cast<double>((i + 3 * j) % 11) - 5.0;
+				}
+			}
+			for (MatrixIndex i = 0; i < k; i++)
+			{
+				for (MatrixIndex j = 0; j < n; j++)
+				{
+					b(i, j) = static_cast<double>((2 * i + j) % 7) - 3.0;
+				}
+			}
+			const TiledMatrix<double, 16> ta(a);
+			const TiledMatrix<double, 16> tb(b);
+			TiledMatrix<double, 16> tc(m, n);
+			for (MatrixIndex i = 0; i < tc.TileRows(); i++)
+			{
+				for (MatrixIndex j = 0; j < tc.TileCols(); j++)
+				{
+					for (MatrixIndex p = 0; p < ta.TileCols(); p++)
+					{
+						Gemm(EXECUTION::SEQ, 1.0, ta.Tile(i, p), tb.Tile(p, j), 1.0, tc.Tile(i, j));
+					}
+				}
+			}
+			BOOST_CHECK(tc == MatMul(a, b));
+
+			BOOST_CHECK_THROW(tc.CopyTo(a), std::invalid_argument);
+
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST51)
+		{
+			// matrices on mapped files: shared, private and read-only mappings
+			const std::string path = (std::filesystem::temp_directory_path() / "sepolia4_matrix_test51.bin").string();
+			const MatrixIndex m = 70;
+			const MatrixIndex n = 45;
+			const size_t offset = 64;
+			const size_t bytes = offset + sizeof(double) * m * n;
+
+			Matrix<double> b(m, n);
+			for (MatrixIndex i = 0; i < m; i++)
+			{
+				for (MatrixIndex j = 0; j < n; j++)
+				{
+					b(i, j) = static_cast<double>((i * n + j) % 97);
+				}
+			}
+
+			{
+				auto file = std::make_shared<MappedFile>(path, bytes);
+				BOOST_CHECK(file->Size() == bytes && file->GetMode() == MapMode::READ_WRITE);
+				Matrix<double> a(m, n, file, offset);
+				file->Advise(AccessPattern::SEQUENTIAL);
+				file.reset();
+
+				// a new file reads as zeros, and every operation runs on the mapping
+				BOOST_CHECK(a.IsMapped() && a.IsContiguous() && a == 0.0);
+				BOOST_CHECK(reinterpret_cast<char*>(a.Data()) == a.GetMappedFile()->Data() + offset);
+				a = b;
+				a += b;
+				a *= 0.5;
+				BOOST_CHECK(a == b && a.Sum() == b.Sum());
+				Matrix<double> c(m, m);
+				Gemm(EXECUTION::SEQ, 1.0, a, b.Transposed(), 0.0, c);
+				BOOST_CHECK(c == MatMul(b, b.Transposed()));
+				a.Block(0, 0, 2, 2) = 1.0;
+				a.Block(0, 0, 2, 2) = b.Block(0, 0, 2, 2);
+
+				// copies are allocated, moves keep the mapping
+				const Matrix<double> copy = a;
+				BOOST_CHECK(!copy.IsMapped() && copy == b);
+				Matrix<double> moved = std::move(a);
+				BOOST_CHECK(moved.IsMapped() && moved == b && a.IsDeallocated());
+				moved.GetMappedFile()->Sync();
+			}
+
+			{
+				// the data is in the file: a read-only mapping sees it through a const view
+				const auto readOnly = std::make_shared<MappedFile>(path, MapMode::READ_ONLY);
+				readOnly->Advise(AccessPattern::RANDOM, offset, 100);
+				const MatrixView<const double> view(reinterpret_cast<const double*>(readOnly->Data() + offset), m, n);
+				BOOST_CHECK(view == b && view.Transposed() == b.Transposed());
+				// but cannot back a matrix, which could write to it
+				BOOST_CHECK_THROW(Matrix<double>(m, n, readOnly, offset), std::invalid_argument);
+				BOOST_CHECK_THROW(ColumnMajorMatrix<double>(n, m, readOnly, offset), std::invalid_argument);
+
+				const auto file = std::make_shared<MappedFile>(path, MapMode::COPY_ON_WRITE);
+				const Matrix<double> a(m, n, file, offset);
+				BOOST_CHECK(a == b && a.Transposed() == b.Transposed());
+
+				// a private mapping leaves the file as it is
+				Matrix<double> w(m, n, std::make_shared<MappedFile>(path, MapMode::COPY_ON_WRITE), offset);
+				w = 3.0;
+				BOOST_CHECK(w == 3.0 && a == b);
+
+				// reallocating moves a matrix to allocated storage
+				w.Allocate(2, 3);
+				BOOST_CHECK(!w.IsMapped() && w == 0.0);
+
+				// column-major matrices keep their layout in the file
+				const ColumnMajorMatrix<double> t(n, m, file, offset);
+				BOOST_CHECK(t == b.Transposed());
+				Matrix<double> u = ColumnMajorMatrix<double>(n, m, file, offset);
+				BOOST_CHECK(!u.IsMapped() && u == b.Transposed());
+
+				BOOST_CHECK_THROW(Matrix<double>(m, n, file, offset + 4), std::invalid_argument);
+				BOOST_CHECK_THROW(Matrix<double>(m, n + 1, file, offset), std::invalid_argument);
+				BOOST_CHECK_THROW(Matrix<double>(m, n, nullptr), std::invalid_argument);
+			}
+
+			std::filesystem::remove(path);
+			BOOST_CHECK_THROW(MappedFile(path, MapMode::READ_ONLY), std::system_error);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST52)
+		{
+			// assignments of transposed views of the matrix itself
+			const auto fill = [](auto& m)
+			{
+				for (MatrixIndex i = 0; i < m.NRows(); i++)
+				{
+					for (MatrixIndex j = 0; j < m.NCols(); j++)
+					{
+						m(i, j) = static_cast<double>(i * 1000 + j);
+					}
+				}
+			};
+
+			Matrix<double> a(64, 64);
+			fill(a);
+			const Matrix<double> at = a.Transposed();
+			a = MatrixView<const double>(a).Transposed();
+			BOOST_CHECK(a == at);
+			a.Assign(EXECUTION::SEQ, MatrixView<const double>(a).Transposed());
+			BOOST_CHECK(a == at.Transposed());
+
+			Matrix<double> padded(33, 33, PADDED);
+			fill(padded);
+			const Matrix<double> paddedT = padded.Transposed();
+			padded = MatrixView<const double>(padded).Transposed();
+			BOOST_CHECK(padded == paddedT);
+
+			ColumnMajorMatrix<double> col(40, 40);
+			fill(col);
+			const ColumnMajorMatrix<double> colT = col.Transposed();
+			col = MatrixView<const double, StorageOrder::COLUMN_MAJOR>(col).Transposed();
+			BOOST_CHECK(col == colT);
+
+			// a rectangular matrix read as its own storage in the other order goes through a buffer
+			Matrix<double> r(6, 10);
+			fill(r);
+			const Matrix<double> rCopy = r;
+			const MatrixView<const double, StorageOrder::COLUMN_MAJOR> alias(r.Data(), 6, 10, 6);
+			const Matrix<double> expected = MatrixView<const double, StorageOrder::COLUMN_MAJOR>(rCopy.Data(), 6, 10, 6);
+			r = alias;
+			BOOST_CHECK(r == expected);
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
 }
 
@@ -0,0 +1,328 @@
+#define BOOST_TEST_DYN_LINK
+
+#include "../Containers/Matrix/Matrix.h"
+#include "../Containers/Vector/Vector.h"
+#include "../Utilities/Parallel.h"
+#include "../Utilities/ThreadPool.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace SEPOLIA4::CONTAINERS;
+using namespace SEPOLIA4::UTILITIES;
+
+namespace SEPOLIA4::BOOST_UNIT_TESTS
+{
+	BOOST_AUTO_TEST_SUITE(UTILITIES_PARALLEL)
+
+		BOOST_AUTO_TEST_CASE(TEST1)
+		{
+			// the chunks cover [0, n) without overlap and their inner boundaries are block multiples
+			for (const size_t n : { 0, 1, 63, 64, 1000, 4097 })
+			{
+				for (const size_t numChunks : { 1, 2, 3, 8 })
+				{
+					for (const size_t blockSize : { 1, 16, 512 })
+					{
+						size_t expectedBegin = 0;
+						for (size_t k = 0; k < numChunks; k++)
+						{
+							const auto range = StaticPartition(n, numChunks, k, blockSize);
+							BOOST_CHECK(range.begin == expectedBegin);
+							BOOST_CHECK(range.begin <= range.end);
+							BOOST_CHECK(range.end == n || range.end % blockSize == 0);
+							expectedBegin = range.end;
+						}
+						BOOST_CHECK(expectedBegin == n);
+					}
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST2)
+		{
+			const auto numThreads = GetNumThreads();
+			BOOST_CHECK(numThreads >= 1);
+
+			for (const size_t threads : { 1, 2, 4, 7 })
+			{
+				SetNumThreads(threads);
+				BOOST_CHECK(GetNumThreads() == threads);
+
+				constexpr size_t DIM = 10007;
+				std::vector<int> visits(DIM, 0);
+				std::atomic<size_t> chunks{ 0 };
+				ParallelFor(DIM, 64, [&](size_t begin, size_t end)
+				{
+					chunks++;
+					for (size_t i = begin; i < end; i++)
+					{
+						visits[i]++;
+					}
+				});
+
+				BOOST_CHECK(chunks == threads);
+				for (size_t i = 0; i < DIM; i++)
+				{
+					BOOST_CHECK(visits[i] == 1);
+				}
+			}
+
+			SetNumThreads(0);
+			BOOST_CHECK(GetNumThreads() == 1);
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST3)
+		{
+			// chunk indices follow the static partition
+			constexpr size_t DIM = 10007;
+			constexpr size_t NUM_CHUNKS = 5;
+			std::vector<size_t> owners(DIM, NUM_CHUNKS);
+			ParallelForChunks(DIM, NUM_CHUNKS, 64, [&](size_t chunkIdx, size_t begin, size_t end)
+			{
+				const auto range = StaticPartition(DIM, NUM_CHUNKS, chunkIdx, 64);
+				BOOST_CHECK(range.begin == begin);
+				BOOST_CHECK(range.end == end);
+				for (size_t i = begin; i < end; i++)
+				{
+					owners[i] = chunkIdx;
+				}
+			});
+
+			for (size_t k = 0; k < NUM_CHUNKS; k++)
+			{
+				const auto range = StaticPartition(DIM, NUM_CHUNKS, k, 64);
+				for (size_t i = range.begin; i < range.end; i++)
+				{
+					BOOST_CHECK(owners[i] == k);
+				}
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST4)
+		{
+			// a task queued behind a blocked one on the same worker is stolen by another worker
+			ThreadPool pool(3);
+			BOOST_CHECK(pool.GetNumWorkers() == 3);
+			BOOST_CHECK(!pool.IsPinned());
+
+			std::atomic<bool> firstStarted{ false };
+			std::atomic<bool> secondDone{ false };
+			std::atomic<bool> firstDone{ false };
+			pool.Submit(0, [&]()
+			{
+				firstStarted = true;
+				const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+				while (!secondDone && std::chrono::steady_clock::now() < deadline)
+				{
+					std::this_thread::yield();
+				}
+				firstDone = true;
+			});
+			while (!firstStarted)
+			{
+				std::this_thread::yield();
+			}
+			pool.Submit(0, [&]()
+			{
+				secondDone = true;
+			});
+			while (!firstDone)
+			{
+				std::this_thread::yield();
+			}
+			BOOST_CHECK(secondDone);
+
+			// many small tasks all land on one deque and are spread over the workers
+			std::atomic<size_t> count{ 0 };
+			for (size_t i = 0; i < 1000; i++)
+			{
+				pool.Submit(1, [&count]()
+				{
+					count++;
+				});
+			}
+			while (pool.RunPendingTask())
+			{
+			}
+			while (count < 1000)
+			{
+				std::this_thread::yield();
+			}
+			BOOST_CHECK(count == 1000);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST5)
+		{
+			// parallel loops on a pool, nested loops and exceptions
+			for (const size_t numWorkers : { 0, 1, 3 })
+			{
+				ThreadPool pool(numWorkers);
+				constexpr size_t DIM = 10007;
+				std::vector<int> visits(DIM, 0);
+				pool.ParallelFor(DIM, 7, 16, [&](size_t, size_t begin, size_t end)
+				{
+					// every chunk runs an inner loop on the same pool
+					pool.ParallelFor(end - begin, 3, 1, [&](size_t, size_t innerBegin, size_t innerEnd)
+					{
+						for (size_t i = begin + innerBegin; i < begin + innerEnd; i++)
+						{
+							visits[i]++;
+						}
+					});
+				});
+				for (size_t i = 0; i < DIM; i++)
+				{
+					BOOST_CHECK(visits[i] == 1);
+				}
+
+				BOOST_CHECK_THROW(pool.ParallelFor(DIM, 4, 16, [](size_t chunkIdx, size_t, size_t)
+				{
+					if (chunkIdx == 2) throw std::runtime_error("chunk 2");
+				}), std::runtime_error);
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST6)
+		{
+			// pinned workers of the process-wide pool
+			const auto numThreads = GetNumThreads();
+			BOOST_CHECK(!GetThreadPinning());
+
+			SetThreadPinning(true);
+			SetNumThreads(4);
+			BOOST_CHECK(GetThreadPinning());
+
+			constexpr size_t DIM = 100003;
+			std::vector<double> values(DIM, 1.0);
+			ParallelFor(DIM, 512, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					values[i] *= 2.0;
+				}
+			});
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(values[i] == 2.0);
+			}
+
+			ThreadPool pool(2, true);
+			BOOST_CHECK(pool.IsPinned());
+			std::atomic<size_t> count{ 0 };
+			pool.ParallelFor(DIM, 3, 512, [&](size_t, size_t begin, size_t end)
+			{
+				count += end - begin;
+			});
+			BOOST_CHECK(count == DIM);
+
+			SetThreadPinning(false);
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST7)
+		{
+			// threaded products inside a parallel loop: a thread waiting for its tiles runs other products
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(8);
+
+			constexpr size_t COUNT = 64;
+			std::vector<Matrix<double>> a;
+			std::vector<Matrix<double>> b;
+			std::vector<Matrix<double>> expected;
+			for (size_t p = 0; p < COUNT; p++)
+			{
+				const auto dim = static_cast<MatrixIndex>(136 + (p % 7) * 8);
+				a.emplace_back(dim, dim);
+				b.emplace_back(dim, dim);
+				for (MatrixIndex i = 0; i < dim; i++)
+				{
+					for (MatrixIndex j = 0; j < dim; j++)
+					{
+						a[p](i, j) = static_cast<double>((i + j + p) % 5) - 2.0;
+						b[p](i, j) = static_cast<double>((2 * i + j) % 3) - 1.0;
+					}
+				}
+				expected.emplace_back(dim, dim);
+				Gemm(EXECUTION::SEQ, 1.0, a[p], b[p], 0.0, expected[p]);
+			}
+
+			std::vector<Matrix<double>> c(COUNT);
+			ParallelForChunks(COUNT, COUNT, 1, [&](size_t, size_t begin, size_t end)
+			{
+				for (size_t p = begin; p < end; p++)
+				{
+					c[p] = Matrix<double>(a[p].NRows(), b[p].NCols());
+					Gemm(EXECUTION::PAR, 1.0, a[p], b[p], 0.0, c[p]);
+				}
+			});
+
+			size_t wrong = 0;
+			for (size_t p = 0; p < COUNT; p++)
+			{
+				if (c[p] != expected[p]) wrong++;
+			}
+			BOOST_CHECK(wrong == 0);
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST8)
+		{
+			// threaded strided matrix-vector products inside a parallel loop
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(8);
+
+			constexpr size_t COUNT = 64;
+			constexpr MatrixIndex DIM = 512;
+			Matrix<double> a(DIM, DIM);
+			for (MatrixIndex i = 0; i < DIM; i++)
+			{
+				for (MatrixIndex j = 0; j < DIM; j++)
+				{
+					a(i, j) = static_cast<double>((i + 3 * j) % 7) - 3.0;
+				}
+			}
+			std::vector<Vector<double>> x;
+			for (size_t p = 0; p < COUNT; p++)
+			{
+				x.emplace_back(2 * DIM);
+				for (size_t i = 0; i < 2 * DIM; i++)
+				{
+					x[p][i] = static_cast<double>((i + p) % 5);
+				}
+			}
+
+			std::vector<Vector<double>> y(COUNT, Vector<double>(3 * DIM));
+			std::vector<Vector<double>> expected(COUNT, Vector<double>(3 * DIM));
+			for (size_t p = 0; p < COUNT; p++)
+			{
+				const Transpose transpose = p % 2 == 0 ? Transpose::NO : Transpose::YES;
+				Gemv(EXECUTION::SEQ, transpose, 1.0, a, x[p].Slice(0, DIM, 2), 0.0, expected[p].Slice(0, DIM, 3));
+			}
+
+			ParallelForChunks(COUNT, COUNT, 1, [&](size_t, size_t begin, size_t end)
+			{
+				for (size_t p = begin; p < end; p++)
+				{
+					const Transpose transpose = p % 2 == 0 ? Transpose::NO : Transpose::YES;
+					Gemv(EXECUTION::PAR, transpose, 1.0, a, x[p].Slice(0, DIM, 2), 0.0, y[p].Slice(0, DIM, 3));
+				}
+			});
+
+			size_t wrong = 0;
+			for (size_t p = 0; p < COUNT; p++)
+			{
+				if (y[p] != expected[p]) wrong++;
+			}
+			BOOST_CHECK(wrong == 0);
+
+			SetNumThreads(numThreads);
+		}
+
+	BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,231 @@
+#define BOOST_TEST_DYN_LINK
+
+#include "../Containers/Serialization/BinaryFormat.h"
+#include "../Utilities/Checksum.h"
+#include "../Utilities/MappedFile.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace SEPOLIA4::CONTAINERS;
+using namespace SEPOLIA4::CONTAINERS::SERIALIZATION;
+using namespace SEPOLIA4::UTILITIES;
+
+namespace SEPOLIA4::BOOST_UNIT_TESTS
+{
+	namespace
+	{
+		std::string TempPath(const std::string& name)
+		{
+			return (std::filesystem::temp_directory_path() / name).string();
+		}
+
+		// flips one byte of the file at path
+		void Corrupt(const std::string& path, uint64_t offset)
+		{
+			std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+			stream.seekg(static_cast<std::streamoff>(offset));
+			char byte = 0;
+			stream.read(&byte, 1);
+			byte = static_cast<char>(~byte);
+			stream.seekp(static_cast<std::streamoff>(offset));
+			stream.write(&byte, 1);
+		}
+
+		// rewrites the header of the file at path with edit, leaving the elements and their checksum as they are
+		template<typename Edit>
+		void Forge(const std::string& path, Edit edit)
+		{
+			std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+			FileHeader header{};
+			stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+			edit(header);
+			stream.seekp(0);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+	}
+
+	BOOST_AUTO_TEST_SUITE(SERIALIZATION)
+
+		BOOST_AUTO_TEST_CASE(TEST1)
+		{
+			// the reference XXH64 digests, in one piece and byte by byte
+			const std::string text = "Nobody inspects the spammish repetition";
+			BOOST_CHECK(Checksum64::Compute("", 0) == 0xEF46DB3751D8E999ULL);
+			BOOST_CHECK(Checksum64::Compute("a", 1) == 0xD24EC4F1A98C6E5BULL);
+			BOOST_CHECK(Checksum64::Compute("abc", 3) == 0x44BC2CF5AD770999ULL);
+			BOOST_CHECK(Checksum64::Compute(text.data(), text.size()) == 0xFBCEA83C8A378BF1ULL);
+
+			Checksum64 checksum;
+			for (const char c : text)
+			{
+				checksum.Update(&c, 1);
+			}
+			BOOST_CHECK(checksum.Digest() == 0xFBCEA83C8A378BF1ULL);
+
+			std::vector<unsigned char> bytes(1000);
+			for (size_t i = 0; i < bytes.size(); i++)
+			{
+				bytes[i] = static_cast<unsigned char>(i * 7);
+			}
+			Checksum64 pieces;
+			pieces.Update(bytes.data(), 5);
+			pieces.Update(bytes.data() + 5, 100);
+			pieces.Update(bytes.data() + 105, 895);
+			BOOST_CHECK(pieces.Digest() == Checksum64::Compute(bytes.data(), bytes.size()));
+			BOOST_CHECK(Checksum64::Compute(bytes.data(), bytes.size(), 1) != Checksum64::Compute(bytes.data(), bytes.size()));
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST2)
+		{
+			// matrices: round trips through files, loaded and mapped
+			static_assert(DataTypeOf<double>() == DataType::FLOAT64 && DataTypeOf<float>() == DataType::FLOAT32);
+			static_assert(DataTypeOf<int8_t>() == DataType::INT8 && DataTypeOf<uint64_t>() == DataType::UINT64);
+			static_assert(DataTypeOf<int32_t>() == DataType::INT32 && DataTypeOf<uint16_t>() == DataType::UINT16);
+
+			const std::string path = TempPath("sepolia4_serialization_test2.bin");
+			const MatrixIndex m = 37;
+			const MatrixIndex n = 53;
+			Matrix<double> a(m, n);
+			for (MatrixIndex i = 0; i < m; i++)
+			{
+				for (MatrixIndex j = 0; j < n; j++)
+				{
+					a(i, j) = static_cast<double>(i) - 0.25 * j;
+				}
+			}
+
+			Save(path, a);
+			BOOST_CHECK(std::filesystem::file_size(path) == sizeof(FileHeader) + sizeof(double) * m * n);
+			const Matrix<double> b = LoadMatrix<double>(path);
+			BOOST_CHECK(b == a);
+
+			// the file is read in place
+			const Matrix<double> c = MapMatrix<double>(path, MapMode::COPY_ON_WRITE, true);
+			BOOST_CHECK(c.IsMapped() && c == a);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(c.Data()) % DATA_ALIGNMENT == 0);
+
+			// the default mapping is private: writes stay in memory
+			{
+				Matrix<double> p = MapMatrix<double>(path);
+				BOOST_CHECK(p.GetMappedFile()->GetMode() == MapMode::COPY_ON_WRITE);
+				p(0, 0) = -1.0;
+				BOOST_CHECK(p.At(0, 0) == -1.0 && c.At(0, 0) == a.At(0, 0));
+			}
+			BOOST_CHECK(LoadMatrix<double>(path) == a);
+			BOOST_CHECK_THROW(MapMatrix<double>(path, MapMode::READ_ONLY), std::invalid_argument);
+
+			// a shared mapping writes to the file
+			{
+				Matrix<double> d = MapMatrix<double>(path, MapMode::READ_WRITE);
+				d(0, 0) = 100.0;
+			}
+			const Matrix<double> e = MapMatrix<double>(path);
+			BOOST_CHECK(e.At(0, 0) == 100.0 && e.At(m - 1, n - 1) == a.At(m - 1, n - 1));
+			// which no longer matches the checksum in the header
+			BOOST_CHECK_THROW(LoadMatrix<double>(path), std::runtime_error);
+
+			// padded matrices and blocks are saved without their padding, column-major ones in their order
+			Matrix<double> padded(m, n, PADDED);
+			padded = a;
+			Save(path, padded);
+			BOOST_CHECK(LoadMatrix<double>(path) == a);
+			Save(path, a.Block(1, 2, 10, 20));
+			BOOST_CHECK(LoadMatrix<double>(path) == a.Block(1, 2, 10, 20));
+
+			const ColumnMajorMatrix<double> col = a;
+			Save(path, col);
+			const ColumnMajorMatrix<double> colMapped = MapMatrix<double, StorageOrder::COLUMN_MAJOR>(path);
+			BOOST_CHECK(colMapped.IsMapped() && colMapped == a);
+			BOOST_CHECK(LoadMatrix<double>(path) == a);
+			BOOST_CHECK((LoadMatrix<double, StorageOrder::COLUMN_MAJOR>(path) == a));
+			BOOST_CHECK_THROW(MapMatrix<double>(path), std::runtime_error);
+
+			// empty matrices and other element types
+			Save(path, Matrix<double>(0, 4));
+			const Matrix<double> empty = LoadMatrix<double>(path);
+			BOOST_CHECK(empty.NRows() == 0 && empty.NCols() == 4);
+			Matrix<int16_t> small{{ 1, -2, 3 },
+								  { -4, 5, -6 }};
+			Save(path, small);
+			BOOST_CHECK(LoadMatrix<int16_t>(path) == small);
+
+			std::filesystem::remove(path);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST3)
+		{
+			// vectors, and the files that are rejected
+			const std::string path = TempPath("sepolia4_serialization_test3.bin");
+			const size_t n = 10000;
+			Vector<float> v(n);
+			for (size_t i = 0; i < n; i++)
+			{
+				v[i] = static_cast<float>(i) * 0.5f;
+			}
+
+			Save(path, v);
+			BOOST_CHECK(LoadVector<float>(path) == v);
+			const Vector<float> mapped = MapVector<float>(path, MapMode::COPY_ON_WRITE, true);
+			BOOST_CHECK(mapped.IsMapped() && mapped == v);
+
+			// another type, another rank
+			BOOST_CHECK_THROW(LoadVector<double>(path), std::runtime_error);
+			BOOST_CHECK_THROW(LoadVector<int32_t>(path), std::runtime_error);
+			BOOST_CHECK_THROW(LoadMatrix<float>(path), std::runtime_error);
+
+			// corrupted elements fail the checksum, when it is verified
+			Corrupt(path, sizeof(FileHeader) + 1234);
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			BOOST_CHECK_THROW(MapVector<float>(path, MapMode::COPY_ON_WRITE, true), std::runtime_error);
+			BOOST_CHECK(MapVector<float>(path).Size() == n);
+
+			// corrupted headers and truncated files
+			Save(path, v);
+			Corrupt(path, 0);
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			BOOST_CHECK_THROW(MapVector<float>(path), std::runtime_error);
+			Save(path, v);
+			std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			BOOST_CHECK_THROW(MapVector<float>(path), std::runtime_error);
+			std::filesystem::resize_file(path, 10);
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+
+			// forged headers, whose shape still matches the size of the elements and the checksum
+			Vector<float> ones(2048);
+			ones = 1.0f;
+			Save(path, ones);
+			Forge(path, [](FileHeader& header)
+			{
+				header.shape[0] = 4;
+				header.shape[1] = 512;
+			});
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			BOOST_CHECK_THROW(MapVector<float>(path), std::runtime_error);
+			Forge(path, [](FileHeader& header)
+			{
+				header.shape[0] = 2048;
+				header.shape[1] = 1;
+				header.reserved = 1;
+			});
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			Forge(path, [](FileHeader& header)
+			{
+				header.reserved = 0;
+			});
+			BOOST_CHECK(LoadVector<float>(path) == ones);
+
+			std::filesystem::remove(path);
+			BOOST_CHECK_THROW(LoadVector<float>(path), std::runtime_error);
+			BOOST_CHECK_THROW(MapVector<float>(path), std::system_error);
+		}
+
+	BOOST_AUTO_TEST_SUITE_END()
+}
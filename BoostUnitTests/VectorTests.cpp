@@ -2,11 +2,19 @@
 #define BOOST_TEST_MAIN  // in only one cpp file
 
 #include "../Containers/Vector/Vector.h"
+#include "../Utilities/CpuFeatures.h"
+#include "../Utilities/MappedFile.h"
+#include "../Utilities/Parallel.h"
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 #include <boost/test/unit_test.hpp>
 
 using namespace SEPOLIA4::CONTAINERS;
+using namespace SEPOLIA4::UTILITIES;
 
 namespace std
 {
@@ -21,6 +29,126 @@ namespace SEPOLIA4::BOOST_UNIT_TESTS
 {
 	constexpr size_t DIM = 10;
 
+	template<typename T>
+	class CountingAllocator
+	{
+	public:
+
+		using value_type = T;
+
+		explicit CountingAllocator(size_t* counter) : m_counter(counter)
+		{
+		}
+
+		template<typename U>
+		CountingAllocator(const CountingAllocator<U>& other) : m_counter(other.m_counter)
+		{
+		}
+
+		T* allocate(size_t n)
+		{
+			(*m_counter)++;
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{
+			(*m_counter)--;
+			std::allocator<T>().deallocate(ptr, n);
+		}
+
+		bool operator==(const CountingAllocator& other) const
+		{
+			return m_counter == other.m_counter;
+		}
+
+		bool operator!=(const CountingAllocator& other) const
+		{
+			return m_counter != other.m_counter;
+		}
+
+		size_t* m_counter;
+	};
+
+	template<typename T>
+	void CheckReductions(size_t dim)
+	{
+		Vector<T> v1(dim);
+		Vector<T> v2(dim);
+		for (size_t i = 0; i < dim; i++)
+		{
+			// small integers: every order of the additions gives the exact result
+			v1[i] = static_cast<T>((i * 7) % 13) - 6;
+			v2[i] = static_cast<T>((i * 5) % 11) - 3;
+		}
+
+		T sum = 0;
+		T dot = 0;
+		size_t argMin = 0;
+		size_t argMax = 0;
+		for (size_t i = 0; i < dim; i++)
+		{
+			sum += v1[i];
+			dot += v1[i] * v2[i];
+			if (v1[i] < v1[argMin]) argMin = i;
+			if (v1[i] > v1[argMax]) argMax = i;
+		}
+
+		BOOST_CHECK(v1.Sum() == sum);
+		BOOST_CHECK(v1.Sum(Summation::KAHAN) == sum);
+		BOOST_CHECK(v1.Sum(Summation::PAIRWISE) == sum);
+		BOOST_CHECK(v1.Dot(v2) == dot);
+		BOOST_CHECK(v1.Min() == v1[argMin]);
+		BOOST_CHECK(v1.Max() == v1[argMax]);
+		BOOST_CHECK(v1.MinMax() == std::make_pair(v1[argMin], v1[argMax]));
+		BOOST_CHECK(v1.ArgMin() == argMin);
+		BOOST_CHECK(v1.ArgMax() == argMax);
+	}
+
+	template<typename T>
+	void CheckSimdKernels(size_t dim)
+	{
+		Vector<T> v1(dim);
+		Vector<T> v2(dim);
+
+		for (size_t i = 0; i < dim; i++)
+		{
+			v1[i] = static_cast<T>(i) + 1;
+			v2[i] = static_cast<T>(2 * i) + 3;
+		}
+
+		const T val = 5;
+		const Vector<T> add = v1 + v2;
+		const Vector<T> sub = v1 - v2;
+		const Vector<T> mul = v1 * v2;
+		const Vector<T> div = v1 / v2;
+		const Vector<T> addVal = v1 + val;
+		const Vector<T> valSub = val - v1;
+		const Vector<T> mulVal = v1 * val;
+		const Vector<T> valDiv = val / v1;
+
+		for (size_t i = 0; i < dim; i++)
+		{
+			BOOST_CHECK(add.At(i) == v1.At(i) + v2.At(i));
+			BOOST_CHECK(sub.At(i) == v1.At(i) - v2.At(i));
+			BOOST_CHECK(mul.At(i) == v1.At(i) * v2.At(i));
+			BOOST_CHECK(div.At(i) == v1.At(i) / v2.At(i));
+			BOOST_CHECK(addVal.At(i) == v1.At(i) + val);
+			BOOST_CHECK(valSub.At(i) == val - v1.At(i));
+			BOOST_CHECK(mulVal.At(i) == v1.At(i) * val);
+			BOOST_CHECK(valDiv.At(i) == val / v1.At(i));
+		}
+
+		Vector<T> v3(v1);
+		v3 *= v2;
+		v3 -= val;
+		v3 /= v2;
+		for (size_t i = 0; i < dim; i++)
+		{
+			BOOST_CHECK(v3.At(i) == (v1.At(i) * v2.At(i) - val) / v2.At(i));
+		}
+	}
+
 	BOOST_AUTO_TEST_SUITE(CONTAINER_VECTOR)
 
 		BOOST_AUTO_TEST_CASE(TEST1)
@@ -579,5 +707,756 @@ namespace SEPOLIA4::BOOST_UNIT_TESTS
 			BOOST_CHECK(v1 == v2);
 		}
 
+		BOOST_AUTO_TEST_CASE(TEST33)
+		{
+			Vector<double> a(DIM);
+			Vector<double> b(DIM);
+			Vector<double> c(DIM);
+			Vector<double> d(DIM);
+
+			for (size_t i = 0; i < DIM; i++)
+			{
+				a[i] = static_cast<double>(i);
+				b[i] = static_cast<double>(i + 1);
+				c[i] = static_cast<double>(i + 2);
+				d[i] = static_cast<double>(i + 3);
+			}
+
+			const Vector<double> res = a + b * c - d;
+			BOOST_CHECK(res.Size() == DIM);
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(res.At(i) == a.At(i) + b.At(i) * c.At(i) - d.At(i));
+			}
+
+			Vector<double> res2;
+			res2 = 2.0 * (a - 1.0) / (b + c) + -d;
+			BOOST_CHECK(res2.Size() == DIM);
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(res2.At(i) == 2.0 * (a.At(i) - 1.0) / (b.At(i) + c.At(i)) + -d.At(i));
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST34)
+		{
+			Vector<double> v1(DIM);
+			Vector<double> v2(DIM);
+
+			for (size_t i = 0; i < DIM; i++)
+			{
+				v1[i] = static_cast<double>(i);
+				v2[i] = static_cast<double>(i + 1);
+			}
+
+			// the target appears inside its own expression
+			v1 = v1 * v1 + v2;
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(v1.At(i) == static_cast<double>(i * i + i + 1));
+			}
+
+			// the target has a different size than the expression
+			Vector<double> v3(2 * DIM);
+			v3 = v1 - v2;
+			BOOST_CHECK(v3.Size() == DIM);
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(v3.At(i) == static_cast<double>(i * i));
+			}
+
+			const auto expr = v1 - v2;
+			BOOST_CHECK(expr.Size() == DIM);
+			BOOST_CHECK(expr == v3);
+			BOOST_CHECK(v3 == expr);
+			BOOST_CHECK(expr != v1);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST35)
+		{
+			// every instruction set up to the detected one, with sizes that leave a remainder
+			const auto detected = CpuFeatures::GetDetectedSimdLevel();
+			for (int level = 0; level <= static_cast<int>(detected); level++)
+			{
+				CpuFeatures::SetSimdLevel(static_cast<SimdLevel>(level));
+				BOOST_CHECK(CpuFeatures::GetSimdLevel() == static_cast<SimdLevel>(level));
+				for (const size_t dim : { 0, 1, 7, 31, 64, 101 })
+				{
+					CheckSimdKernels<double>(dim);
+					CheckSimdKernels<float>(dim);
+				}
+			}
+			CpuFeatures::SetSimdLevel(detected);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST36)
+		{
+			// the default allocator aligns the storage to a cache line
+			for (const size_t dim : { 1, 3, 17, 1000 })
+			{
+				Vector<double> v1(dim);
+				Vector<float> v2(dim);
+				BOOST_CHECK(reinterpret_cast<uintptr_t>(v1.Data()) % CACHE_LINE_SIZE == 0);
+				BOOST_CHECK(reinterpret_cast<uintptr_t>(v2.Data()) % CACHE_LINE_SIZE == 0);
+				BOOST_CHECK(v1 == 0.0);
+				BOOST_CHECK(v2 == 0.0f);
+			}
+
+			Vector<double, AlignedAllocator<double, 4096>> v3(DIM);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(v3.Data()) % 4096 == 0);
+			v3 = 2.0;
+			v3 += v3 * 3.0;
+			BOOST_CHECK(v3 == 8.0);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST37)
+		{
+			// a stateful allocator travels with the vector (sizes beyond the small buffer)
+			constexpr size_t DIM = 10 * Vector<double>::INLINE_CAPACITY;
+			size_t liveBlocks = 0;
+			{
+				using VectorType = Vector<double, CountingAllocator<double>>;
+				const CountingAllocator<double> allocator(&liveBlocks);
+
+				VectorType v1(DIM, allocator);
+				BOOST_CHECK(liveBlocks == 1);
+				v1 = 1.0;
+
+				VectorType v2(v1);
+				BOOST_CHECK(liveBlocks == 2);
+				BOOST_CHECK(v2 == 1.0);
+				BOOST_CHECK(v2.GetAllocator() == allocator);
+
+				VectorType v3(std::move(v1));
+				BOOST_CHECK(liveBlocks == 2);
+				BOOST_CHECK(v3.Size() == DIM);
+
+				VectorType v4(allocator);
+				v4 = v2 + v3;
+				BOOST_CHECK(liveBlocks == 3);
+				BOOST_CHECK(v4 == 2.0);
+
+				v4.Deallocate();
+				BOOST_CHECK(liveBlocks == 2);
+			}
+			BOOST_CHECK(liveBlocks == 0);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST38)
+		{
+			Vector<double> v1(DIM, UNINITIALIZED);
+			BOOST_CHECK(v1.Size() == DIM);
+			BOOST_CHECK(v1.IsAllocated());
+			v1 = 4.0;
+			BOOST_CHECK(v1 == 4.0);
+
+			Vector<double> v2;
+			BOOST_CHECK(v2.AllocateUninitialized(2 * DIM));
+			BOOST_CHECK(v2.Size() == 2 * DIM);
+			for (size_t i = 0; i < v2.Size(); i++)
+			{
+				v2[i] = static_cast<double>(i);
+			}
+			v1 = v2;
+			BOOST_CHECK(v1 == v2);
+
+			// non-trivial types are still constructed
+			Vector<std::vector<int>> v3(DIM, UNINITIALIZED);
+			BOOST_CHECK(v3.At(DIM - 1).empty());
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST39)
+		{
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+
+			constexpr size_t BIG_DIM = 100003;
+			Vector<double> v1(BIG_DIM, PARALLEL_FIRST_TOUCH);
+			BOOST_CHECK(v1.Size() == BIG_DIM);
+			BOOST_CHECK(v1 == 0.0);
+
+			Vector<double> v2;
+			BOOST_CHECK(v2.Allocate(DIM, PARALLEL_FIRST_TOUCH));
+			BOOST_CHECK(v2.Size() == DIM);
+			BOOST_CHECK(v2 == 0.0);
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST40)
+		{
+			// short vectors live inside the object and never reach the allocator
+			BOOST_CHECK(Vector<double>::INLINE_CAPACITY == 16);
+			BOOST_CHECK(Vector<std::vector<int>>::INLINE_CAPACITY == 0);
+
+			size_t liveBlocks = 0;
+			using VectorType = Vector<double, CountingAllocator<double>>;
+			const CountingAllocator<double> allocator(&liveBlocks);
+
+			VectorType v1(VectorType::INLINE_CAPACITY, allocator);
+			BOOST_CHECK(v1.IsInline());
+			BOOST_CHECK(liveBlocks == 0);
+			BOOST_CHECK(v1 == 0.0);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(v1.Data()) % CACHE_LINE_SIZE == 0);
+			for (size_t i = 0; i < v1.Size(); i++)
+			{
+				v1[i] = static_cast<double>(i);
+			}
+
+			// copies and moves keep the elements and point to their own buffer
+			VectorType v2(v1);
+			BOOST_CHECK(v2.IsInline());
+			BOOST_CHECK(v2.Data() != v1.Data());
+			BOOST_CHECK(v2 == v1);
+
+			VectorType v3(std::move(v1));
+			BOOST_CHECK(v3.IsInline());
+			BOOST_CHECK(v3 == v2);
+			BOOST_CHECK(v1.Size() == 0);
+			BOOST_CHECK(v1.IsDeallocated());
+
+			VectorType v4(allocator);
+			v4 = std::move(v3);
+			BOOST_CHECK(v4.IsInline());
+			BOOST_CHECK(v4 == v2);
+			v4 += v2 * 2.0;
+			for (size_t i = 0; i < v4.Size(); i++)
+			{
+				BOOST_CHECK(v4.At(i) == 3.0 * static_cast<double>(i));
+			}
+
+			// one element more goes to the heap
+			VectorType v5(VectorType::INLINE_CAPACITY + 1, allocator);
+			BOOST_CHECK(!v5.IsInline());
+			BOOST_CHECK(liveBlocks == 1);
+			v5 = v4;
+			BOOST_CHECK(v5.IsInline());
+			BOOST_CHECK(liveBlocks == 0);
+			BOOST_CHECK(v5 == v4);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST41)
+		{
+			// appending grows the capacity geometrically, from the small buffer to the heap
+			size_t liveBlocks = 0;
+			using VectorType = Vector<double, CountingAllocator<double>>;
+			const CountingAllocator<double> allocator(&liveBlocks);
+
+			VectorType v1(allocator);
+			BOOST_CHECK(v1.Capacity() == 0);
+			v1.PushBack(0.0);
+			BOOST_CHECK(v1.IsInline());
+			BOOST_CHECK(v1.Capacity() == VectorType::INLINE_CAPACITY);
+			BOOST_CHECK(liveBlocks == 0);
+
+			constexpr size_t NUM_ELEMENTS = 1000;
+			size_t numGrowths = 0;
+			for (size_t i = 1; i < NUM_ELEMENTS; i++)
+			{
+				const size_t capacity = v1.Capacity();
+				if (i % 2 == 0)
+				{
+					v1.PushBack(static_cast<double>(i));
+				}
+				else
+				{
+					BOOST_CHECK(v1.EmplaceBack(static_cast<double>(i)) == static_cast<double>(i));
+				}
+				if (v1.Capacity() != capacity)
+				{
+					BOOST_CHECK(v1.Capacity() >= 2 * capacity);
+					numGrowths++;
+				}
+			}
+			BOOST_CHECK(!v1.IsInline());
+			BOOST_CHECK(liveBlocks == 1);
+			BOOST_CHECK(numGrowths <= 6);
+			BOOST_CHECK(v1.Size() == NUM_ELEMENTS);
+			for (size_t i = 0; i < v1.Size(); i++)
+			{
+				BOOST_CHECK(v1.At(i) == static_cast<double>(i));
+			}
+
+			// pushing back an element of the vector itself while it grows
+			VectorType v2(allocator);
+			v2.PushBack(7.0);
+			for (size_t i = 0; i < 100; i++)
+			{
+				v2.PushBack(v2[0]);
+			}
+			BOOST_CHECK(v2 == 7.0);
+
+			v1.Deallocate();
+			v2.Deallocate();
+			BOOST_CHECK(liveBlocks == 0);
+			BOOST_CHECK(v1.Capacity() == 0);
+
+			// types that are not trivially copyable are moved to the new storage
+			Vector<std::vector<int>> v3;
+			for (int i = 0; i < 100; i++)
+			{
+				v3.EmplaceBack(static_cast<size_t>(i), i);
+			}
+			for (size_t i = 0; i < v3.Size(); i++)
+			{
+				BOOST_CHECK(v3[i].size() == i);
+				BOOST_CHECK(std::all_of(v3[i].begin(), v3[i].end(), [&](int el) { return el == static_cast<int>(i); }));
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST42)
+		{
+			// Reserve and Resize
+			size_t liveBlocks = 0;
+			using VectorType = Vector<double, CountingAllocator<double>>;
+			const CountingAllocator<double> allocator(&liveBlocks);
+
+			VectorType v1(allocator);
+			BOOST_CHECK(v1.Reserve(1000));
+			BOOST_CHECK(v1.Capacity() == 1000);
+			BOOST_CHECK(v1.Size() == 0);
+			BOOST_CHECK(liveBlocks == 1);
+			const double* data = v1.Data();
+			for (size_t i = 0; i < 1000; i++)
+			{
+				v1.PushBack(1.0);
+			}
+			BOOST_CHECK(v1.Data() == data);
+			BOOST_CHECK(v1.Reserve(10));
+			BOOST_CHECK(v1.Capacity() == 1000);
+
+			BOOST_CHECK(v1.Resize(10));
+			BOOST_CHECK(v1.Size() == 10);
+			BOOST_CHECK(v1.Capacity() == 1000);
+			BOOST_CHECK(v1 == 1.0);
+
+			BOOST_CHECK(v1.Resize(1500));
+			BOOST_CHECK(v1.Size() == 1500);
+			BOOST_CHECK(v1.Capacity() == 2000);
+			BOOST_CHECK(liveBlocks == 1);
+			for (size_t i = 0; i < v1.Size(); i++)
+			{
+				BOOST_CHECK(v1.At(i) == (i < 10 ? 1.0 : 0.0));
+			}
+
+			// a vector of a fixed size can grow too
+			Vector<double> v2(DIM);
+			v2 = 2.0;
+			BOOST_CHECK(v2.Resize(2 * DIM));
+			BOOST_CHECK(v2.Size() == 2 * DIM);
+			for (size_t i = 0; i < v2.Size(); i++)
+			{
+				BOOST_CHECK(v2.At(i) == (i < DIM ? 2.0 : 0.0));
+			}
+
+			Vector<std::vector<int>> v3(DIM);
+			BOOST_CHECK(v3.Resize(3));
+			BOOST_CHECK(v3.Size() == 3);
+			BOOST_CHECK(v3.Resize(5 * DIM));
+			BOOST_CHECK(v3.Size() == 5 * DIM);
+			BOOST_CHECK(v3[5 * DIM - 1].empty());
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST43)
+		{
+			// large blocks of the aligned allocator are mapped and remapped on growth
+			using AllocatorType = AlignedAllocator<double>;
+			constexpr size_t BIG_DIM = 2 * AllocatorType::MMAP_THRESHOLD / sizeof(double);
+
+			AllocatorType allocator;
+			double* data = allocator.allocate(BIG_DIM);
+			BOOST_CHECK(reinterpret_cast<uintptr_t>(data) % CACHE_LINE_SIZE == 0);
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				data[i] = static_cast<double>(i);
+			}
+			data = allocator.reallocate(data, BIG_DIM, 4 * BIG_DIM);
+			bool ok = true;
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				ok = ok && data[i] == static_cast<double>(i);
+			}
+			BOOST_CHECK(ok);
+			data = allocator.reallocate(data, 4 * BIG_DIM, DIM);
+			for (size_t i = 0; i < DIM; i++)
+			{
+				BOOST_CHECK(data[i] == static_cast<double>(i));
+			}
+			allocator.deallocate(data, DIM);
+
+			BOOST_CHECK(HasReallocate<AllocatorType>::value);
+			BOOST_CHECK(!HasReallocate<CountingAllocator<double>>::value);
+
+			// appending to a vector across the threshold
+			Vector<double> v1;
+			for (size_t i = 0; i < 2 * BIG_DIM; i++)
+			{
+				v1.PushBack(static_cast<double>(i));
+			}
+			BOOST_CHECK(v1.Size() == 2 * BIG_DIM);
+			BOOST_CHECK(v1.Capacity() >= 2 * BIG_DIM);
+			ok = true;
+			for (size_t i = 0; i < v1.Size(); i++)
+			{
+				ok = ok && v1.At(i) == static_cast<double>(i);
+			}
+			BOOST_CHECK(ok);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST44)
+		{
+			// reductions against plain loops, on every instruction set and across the SIMD tails
+			const auto detected = CpuFeatures::GetDetectedSimdLevel();
+			for (const auto level : { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+			{
+				CpuFeatures::SetSimdLevel(level);
+				for (const size_t dim : { 1, 2, 7, 16, 33, 64, 65, 127, 1000, 1031 })
+				{
+					CheckReductions<double>(dim);
+					CheckReductions<float>(dim);
+					CheckReductions<int>(dim);
+				}
+			}
+			CpuFeatures::SetSimdLevel(detected);
+
+			Vector<double> v1;
+			BOOST_CHECK(v1.Sum() == 0.0);
+			BOOST_CHECK(v1.Dot(v1) == 0.0);
+			BOOST_CHECK(v1.Norm2() == 0.0);
+
+			const Vector<double> v2{ 3.0, 4.0 };
+			BOOST_CHECK(v2.Norm2() == 5.0);
+			const Vector<double> v3{ 1.0, 5.0, -2.0, 5.0, -2.0 };
+			BOOST_CHECK(v3.ArgMax() == 1);
+			BOOST_CHECK(v3.ArgMin() == 2);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST45)
+		{
+			// compensated summations and the multi-threaded path
+			constexpr size_t BIG_DIM = 1000003;
+			Vector<double> v1(BIG_DIM, UNINITIALIZED);
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				v1[i] = 0.1;
+			}
+			v1[0] = 1.0e10;
+
+			// the exact sum is 1e10 + 100000.2
+			const double exact = 1.0e10 + 0.1 * static_cast<double>(BIG_DIM - 1);
+			const double errorKahan = std::fabs(v1.Sum(Summation::KAHAN) - exact);
+			const double errorPairwise = std::fabs(v1.Sum(Summation::PAIRWISE) - exact);
+			double naive = 0.0;
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				naive += v1[i];
+			}
+			BOOST_CHECK(errorKahan <= 1.0e-5);
+			BOOST_CHECK(errorPairwise <= 1.0e-4);
+			BOOST_CHECK(errorKahan < std::fabs(naive - exact));
+
+			const auto numThreads = GetNumThreads();
+			for (const size_t threads : { 1, 3, 4 })
+			{
+				SetNumThreads(threads);
+				for (size_t i = 0; i < BIG_DIM; i++)
+				{
+					v1[i] = static_cast<double>(i % 1000);
+				}
+				v1[BIG_DIM / 2] = -1.0;
+				v1[BIG_DIM - 2] = 5000.0;
+				v1[BIG_DIM - 1] = 5000.0;
+
+				double sum = 0.0;
+				double dot = 0.0;
+				for (size_t i = 0; i < BIG_DIM; i++)
+				{
+					sum += v1[i];
+					dot += v1[i] * v1[i];
+				}
+
+				BOOST_CHECK(v1.Sum() == sum);
+				BOOST_CHECK(v1.Sum(Summation::KAHAN) == sum);
+				BOOST_CHECK(v1.Sum(Summation::PAIRWISE) == sum);
+				BOOST_CHECK(v1.Dot(v1) == dot);
+				BOOST_CHECK(std::fabs(v1.Norm2() - std::sqrt(dot)) <= 1.0e-12 * std::sqrt(dot));
+				BOOST_CHECK(v1.Min() == -1.0);
+				BOOST_CHECK(v1.Max() == 5000.0);
+				BOOST_CHECK(v1.MinMax() == std::make_pair(-1.0, 5000.0));
+				BOOST_CHECK(v1.ArgMin() == BIG_DIM / 2);
+				BOOST_CHECK(v1.ArgMax() == BIG_DIM - 2);
+			}
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST46)
+		{
+			// every execution policy gives the same results as the default operators
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+
+			constexpr size_t BIG_DIM = 300007;
+			Vector<double> v1(BIG_DIM, UNINITIALIZED);
+			Vector<double> v2(BIG_DIM, UNINITIALIZED);
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				v1[i] = static_cast<double>(i % 1000);
+				v2[i] = static_cast<double>(i % 7) + 1.0;
+			}
+
+			Vector<double> expected = v1 + v2;
+			expected *= v2;
+			expected -= 3.0;
+			expected /= v2;
+			expected += 0.5;
+
+			const auto check = [&](auto policy)
+			{
+				Vector<double> v3;
+				v3.Assign(policy, v1 + v2);
+				v3.Multiply(policy, v2).Subtract(policy, 3.0).Divide(policy, v2).Add(policy, 0.5);
+				BOOST_CHECK(v3 == expected);
+
+				Vector<double> v4;
+				v4.Assign(policy, v1);
+				BOOST_CHECK(v4 == v1);
+				v4.Fill(policy, 2.0);
+				BOOST_CHECK(v4 == 2.0);
+				v4.Multiply(policy, 4.0).Add(policy, v2).Subtract(policy, v2).Divide(policy, 2.0);
+				BOOST_CHECK(v4 == 4.0);
+
+				BOOST_CHECK(v1.Sum(policy) == v1.Sum());
+				BOOST_CHECK(v1.Sum(policy, Summation::KAHAN) == v1.Sum(Summation::KAHAN));
+				BOOST_CHECK(v1.Dot(policy, v2) == v1.Dot(v2));
+				BOOST_CHECK(v1.Norm2(policy) == v1.Norm2());
+				BOOST_CHECK(v1.MinMax(policy) == std::make_pair(0.0, 999.0));
+				BOOST_CHECK(v1.ArgMin(policy) == 0);
+				BOOST_CHECK(v1.ArgMax(policy) == 999);
+			};
+			check(EXECUTION::SEQ);
+			check(EXECUTION::UNSEQ);
+			check(EXECUTION::PAR);
+			check(EXECUTION::PAR_UNSEQ);
+
+			// sequenced operations inside the bodies of an outer parallel loop
+			constexpr size_t NUM_VECTORS = 8;
+			std::vector<Vector<double>> vectors(NUM_VECTORS);
+			ParallelFor(NUM_VECTORS, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t k = begin; k < end; k++)
+				{
+					vectors[k].Assign(EXECUTION::SEQ, v1 * static_cast<double>(k));
+				}
+			});
+			for (size_t k = 0; k < NUM_VECTORS; k++)
+			{
+				BOOST_CHECK(vectors[k] == v1 * static_cast<double>(k));
+			}
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST47)
+		{
+			// strided views: slices of a vector without copies
+			Vector<double> v1{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0 };
+			VectorView<double> even = v1.Slice(0, 4, 2);
+			VectorView<double> odd = v1.Slice(1, 4, 2);
+			BOOST_CHECK(even.Size() == 4);
+			BOOST_CHECK(even.Stride() == 2);
+			BOOST_CHECK(!even.IsContiguous());
+			BOOST_CHECK(even[3] == 7.0);
+			BOOST_CHECK(odd.At(0) == 2.0);
+
+			// a view is an expression: it mixes with vectors and other views
+			const Vector<double> v2 = even + odd;
+			BOOST_CHECK(v2 == Vector<double>({ 3.0, 7.0, 11.0, 15.0 }));
+			BOOST_CHECK((2.0 * even - odd) == Vector<double>({ 0.0, 2.0, 4.0, 6.0 }));
+
+			// writes through the view reach the vector
+			even += odd;
+			BOOST_CHECK(v1 == Vector<double>({ 3.0, 2.0, 7.0, 4.0, 11.0, 6.0, 15.0, 8.0 }));
+			odd = 0.0;
+			BOOST_CHECK(v1 == Vector<double>({ 3.0, 0.0, 7.0, 0.0, 11.0, 0.0, 15.0, 0.0 }));
+			odd = even / 2.0;
+			BOOST_CHECK(v1 == Vector<double>({ 3.0, 1.5, 7.0, 3.5, 11.0, 5.5, 15.0, 7.5 }));
+			even.SubView(1, 2, 2) *= 10.0;
+			BOOST_CHECK(v1 == Vector<double>({ 3.0, 1.5, 70.0, 3.5, 11.0, 5.5, 150.0, 7.5 }));
+
+			// copying a view copies the reference, assigning writes the elements
+			VectorView<double> copy = even;
+			BOOST_CHECK(copy.Data() == v1.Data());
+			even = odd;
+			BOOST_CHECK(v1 == Vector<double>({ 1.5, 1.5, 3.5, 3.5, 5.5, 5.5, 7.5, 7.5 }));
+
+			// reductions over strided and contiguous views
+			const Vector<double> v3{ 4.0, -1.0, 3.0, 9.0, -5.0, 2.0, 8.0, 0.0, 6.0 };
+			VectorView<const double> view3 = v3.Slice(1, 4, 2);
+			BOOST_CHECK(view3.Sum() == 10.0);
+			BOOST_CHECK(view3.Sum(Summation::KAHAN) == 10.0);
+			BOOST_CHECK(view3.Sum(Summation::PAIRWISE) == 10.0);
+			BOOST_CHECK(view3.Dot(view3) == 86.0);
+			BOOST_CHECK(view3.Dot(v3.Slice(0, 4)) == -7.0);
+			BOOST_CHECK(view3.Min() == -1.0);
+			BOOST_CHECK(view3.Max() == 9.0);
+			BOOST_CHECK(view3.MinMax() == std::make_pair(-1.0, 9.0));
+			BOOST_CHECK(view3.ArgMin() == 0);
+			BOOST_CHECK(view3.ArgMax() == 1);
+			BOOST_CHECK(v3.Slice(2, 3).Sum() == 7.0);
+			BOOST_CHECK(v3.Dot(v3.Slice(0, 9)) == v3.Dot(v3));
+			const VectorView<const double> whole = v3;
+			BOOST_CHECK(whole.Size() == v3.Size());
+			BOOST_CHECK(std::fabs(whole.Norm2() - v3.Norm2()) <= 1.0e-14);
+
+			// large views, contiguous and strided, under every policy
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(4);
+			constexpr size_t BIG_DIM = 600000;
+			Vector<double> v4(BIG_DIM, UNINITIALIZED);
+			for (size_t i = 0; i < BIG_DIM; i++)
+			{
+				v4[i] = static_cast<double>(i % 1000);
+			}
+			const Vector<double> v5 = v4;
+			const auto check = [&](auto policy)
+			{
+				v4.Slice(0, BIG_DIM / 2, 2).Multiply(policy, 2.0).Add(policy, v5.Slice(1, BIG_DIM / 2, 2));
+				v4.Slice(BIG_DIM / 2, BIG_DIM / 2).Subtract(policy, v5.Slice(0, BIG_DIM / 2)).Add(policy, 1.0);
+				bool ok = true;
+				for (size_t i = 0; i < BIG_DIM; i++)
+				{
+					double expected = v5[i];
+					if (i % 2 == 0) expected = 2.0 * v5[i] + v5[i + 1];
+					if (i >= BIG_DIM / 2) expected -= v5[i - BIG_DIM / 2] - 1.0;
+					ok = ok && v4[i] == expected;
+				}
+				BOOST_CHECK(ok);
+
+				const auto strided = v5.Slice(1, BIG_DIM / 3, 3);
+				double sum = 0.0;
+				for (size_t i = 0; i < strided.Size(); i++)
+				{
+					sum += strided[i];
+				}
+				BOOST_CHECK(strided.Sum(policy) == sum);
+				BOOST_CHECK(strided.MinMax(policy) == std::make_pair(0.0, 999.0));
+				BOOST_CHECK(strided.ArgMax(policy) == 666);
+				BOOST_CHECK(v5.Slice(0, BIG_DIM).Sum(policy) == v5.Sum(policy));
+				v4.Assign(policy, v5);
+			};
+			check(EXECUTION::SEQ);
+			check(EXECUTION::UNSEQ);
+			check(EXECUTION::PAR);
+			check(EXECUTION::PAR_UNSEQ);
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST48)
+		{
+			// AXPY, DOT and SCAL: the BLAS backend of PAR_UNSEQ against the native kernels of UNSEQ
+			const auto check = [](auto zero, size_t dim)
+			{
+				using T = decltype(zero);
+				Vector<T> x(dim, UNINITIALIZED);
+				Vector<T> y(dim, UNINITIALIZED);
+				for (size_t i = 0; i < dim; i++)
+				{
+					x[i] = static_cast<T>(i % 9) - T(4);
+					y[i] = static_cast<T>(i % 5);
+				}
+
+				// small integers: every order of the additions gives the exact result
+				Vector<T> y1(y);
+				Vector<T> y2(y);
+				y1.Axpy(EXECUTION::UNSEQ, T(3), x);
+				y2.Axpy(T(3), x);
+				BOOST_CHECK(y1 == y2);
+				for (size_t i = 0; i < dim; i++)
+				{
+					BOOST_CHECK(y1[i] == y[i] + T(3) * x[i]);
+				}
+
+				BOOST_CHECK(x.Dot(EXECUTION::UNSEQ, y) == x.Dot(y));
+				BOOST_CHECK(x.Slice(0, dim / 2).Dot(EXECUTION::UNSEQ, y.Slice(1, dim / 2, 2)) ==
+							x.Slice(0, dim / 2).Dot(y.Slice(1, dim / 2, 2)));
+
+				y1.Multiply(EXECUTION::UNSEQ, T(-2));
+				y2 *= T(-2);
+				BOOST_CHECK(y1 == y2);
+
+				// an infinity times 0 is NaN on both paths
+				if constexpr (std::is_floating_point_v<T>)
+				{
+					y2[dim - 1] = std::numeric_limits<T>::infinity();
+					y2 *= T(0);
+					BOOST_CHECK(std::isnan(y2[dim - 1]));
+					BOOST_CHECK(y2[0] == T(0));
+				}
+
+				// strided views as the x of AXPY
+				Vector<T> z(dim / 2);
+				z.Axpy(T(1), x.Slice(0, dim / 2, 2));
+				for (size_t i = 0; i < dim / 2; i++)
+				{
+					BOOST_CHECK(z[i] == x[2 * i]);
+				}
+			};
+			// below and above KERNELS::BLAS_MIN_LEVEL1_SIZE
+			check(0.0, 101);
+			check(0.0f, 101);
+			check(0.0, 100003);
+			check(0.0f, 100003);
+			check(0, 1001);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST49)
+		{
+			// vectors on mapped files
+			const std::string path = (std::filesystem::temp_directory_path() / "sepolia4_vector_test49.bin").string();
+			const size_t n = 1000;
+
+			Vector<float> b(n);
+			for (size_t i = 0; i < n; i++)
+			{
+				b[i] = static_cast<float>(i % 17);
+			}
+
+			{
+				Vector<float> a(n, std::make_shared<MappedFile>(path, n * sizeof(float)));
+				BOOST_CHECK(a.IsMapped() && !a.IsInline() && a.Size() == n && a == 0.0f);
+				a = b;
+				a += b;
+				a -= b;
+				BOOST_CHECK(a == b && a.Sum() == b.Sum() && a.Dot(b) == b.Dot(b));
+
+				// growing moves the elements to allocated storage, the file keeps them
+				Vector<float> c = std::move(a);
+				BOOST_CHECK(c.IsMapped() && !a.IsMapped());
+				const auto file = c.GetMappedFile();
+				c.PushBack(-1.0f);
+				BOOST_CHECK(!c.IsMapped() && c.Size() == n + 1 && c[n] == -1.0f);
+				BOOST_CHECK(Vector<float>(n, file) == b);
+			}
+
+			{
+				const auto readOnly = std::make_shared<MappedFile>(path, MapMode::READ_ONLY);
+				BOOST_CHECK(VectorView<const float>(reinterpret_cast<const float*>(readOnly->Data()), n) == b);
+				BOOST_CHECK_THROW(Vector<float>(n, readOnly), std::invalid_argument);
+
+				const auto file = std::make_shared<MappedFile>(path, MapMode::COPY_ON_WRITE);
+				file->Advise(AccessPattern::WILL_NEED);
+				const Vector<float> a(n, file);
+				BOOST_CHECK(a == b);
+				const Vector<float> tail(n / 2, file, n / 2 * sizeof(float));
+				BOOST_CHECK(tail[0] == b[n / 2]);
+				BOOST_CHECK_THROW(Vector<float>(n, file, 2), std::invalid_argument);
+				BOOST_CHECK_THROW(Vector<float>(n + 1, file), std::invalid_argument);
+			}
+
+			std::filesystem::remove(path);
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
 }
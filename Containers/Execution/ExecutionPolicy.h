@@ -0,0 +1,58 @@
+#pragma once
+
+#include <type_traits>
+
+namespace SEPOLIA4::CONTAINERS::EXECUTION
+{
+	//====================================================================//
+	// Execution policies in the style of std::execution, selecting per   //
+	// call whether a container operation may use the worker threads      //
+	// (PARALLEL) and the explicit SIMD kernels (VECTORIZED).             //
+	// Parallel policies still run loops below KERNELS::PARALLEL_MIN_SIZE //
+	// on the calling thread only. The operations without a policy        //
+	// argument use PAR_UNSEQ.                                            //
+	//====================================================================//
+
+	struct SequencedPolicy
+	{
+		static constexpr bool PARALLEL = false;
+		static constexpr bool VECTORIZED = false;
+	};
+
+	struct UnsequencedPolicy
+	{
+		static constexpr bool PARALLEL = false;
+		static constexpr bool VECTORIZED = true;
+	};
+
+	struct ParallelPolicy
+	{
+		static constexpr bool PARALLEL = true;
+		static constexpr bool VECTORIZED = false;
+	};
+
+	struct ParallelUnsequencedPolicy
+	{
+		static constexpr bool PARALLEL = true;
+		static constexpr bool VECTORIZED = true;
+	};
+
+	// on one thread, plain loops: for the bodies of already-parallel outer loops
+	inline constexpr SequencedPolicy SEQ{};
+
+	// on one thread, SIMD kernels
+	inline constexpr UnsequencedPolicy UNSEQ{};
+
+	// on the worker threads, plain loops
+	inline constexpr ParallelPolicy PAR{};
+
+	// on the worker threads, SIMD kernels
+	inline constexpr ParallelUnsequencedPolicy PAR_UNSEQ{};
+
+	template<typename Policy>
+	constexpr bool IS_EXECUTION_POLICY =
+			std::is_same_v<std::decay_t<Policy>, SequencedPolicy> ||
+			std::is_same_v<std::decay_t<Policy>, UnsequencedPolicy> ||
+			std::is_same_v<std::decay_t<Policy>, ParallelPolicy> ||
+			std::is_same_v<std::decay_t<Policy>, ParallelUnsequencedPolicy>;
+}
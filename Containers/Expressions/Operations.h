@@ -0,0 +1,72 @@
+#pragma once
+
+namespace SEPOLIA4::CONTAINERS::OPERATIONS
+{
+	//===================================================//
+	// Elementwise functors shared by the expression     //
+	// templates of the containers (Vector, Matrix, ...) //
+	//===================================================//
+
+	struct Plus
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return a + b;
+		}
+	};
+
+	struct Minus
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return a - b;
+		}
+	};
+
+	struct Multiplies
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return a * b;
+		}
+	};
+
+	struct Divides
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return a / b;
+		}
+	};
+
+	struct Min
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return b < a ? b : a;
+		}
+	};
+
+	struct Max
+	{
+		template<typename A, typename B>
+		static auto Apply(const A& a, const B& b)
+		{
+			return a < b ? b : a;
+		}
+	};
+
+	struct Negate
+	{
+		template<typename A>
+		static auto Apply(const A& a)
+		{
+			return -a;
+		}
+	};
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+#include "../Execution/ExecutionPolicy.h"
+
+#ifdef SEPOLIA4_USE_CBLAS
+#include <cblas.h>
+#endif
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//=============================================================//
+	// Backend of the float and double containers on the CBLAS     //
+	// interface of the linked BLAS library (OpenBLAS, MKL, ...),  //
+	// compiled in when the build defines SEPOLIA4_USE_CBLAS.      //
+	// Only PAR_UNSEQ calls go to BLAS, since the vendor libraries //
+	// run their own threads and SIMD kernels, and only from the   //
+	// BLAS_MIN_* sizes on: below them the call overhead and the   //
+	// start-up of the library threads cost more than the native   //
+	// kernels spend on the whole problem.                         //
+	//=============================================================//
+
+#ifdef SEPOLIA4_USE_CBLAS
+	constexpr bool HAS_CBLAS = true;
+#else
+	constexpr bool HAS_CBLAS = false;
+#endif
+
+	// elements of the vector for AXPY, DOT and SCAL
+	constexpr size_t BLAS_MIN_LEVEL1_SIZE = size_t(1) << 14;
+
+	// elements of the matrix for GEMV
+	constexpr size_t BLAS_MIN_GEMV_SIZE = size_t(1) << 14;
+
+	// m * n * k for GEMM, a product of two 64 x 64 matrices
+	constexpr size_t BLAS_MIN_GEMM_SIZE = size_t(1) << 18;
+
+	inline std::atomic<bool>& BlasEnabled()
+	{
+		static std::atomic<bool> enabled{ true };
+		return enabled;
+	}
+
+	// whether UseBlas may pick BLAS at all (true by default); switched off, PAR_UNSEQ runs
+	// the native kernels on the worker threads, e.g. to compare them with the library
+	inline bool IsBlasEnabled()
+	{
+		return BlasEnabled().load(std::memory_order_relaxed);
+	}
+
+	inline void SetBlasEnabled(bool enabled)
+	{
+		BlasEnabled().store(enabled, std::memory_order_relaxed);
+	}
+
+	template<typename T, typename Policy>
+	constexpr bool IS_BLAS_CANDIDATE = HAS_CBLAS && (std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+									   std::decay_t<Policy>::PARALLEL && std::decay_t<Policy>::VECTORIZED;
+
+	// whether an operation of the given work goes to BLAS; dims are the sizes, strides
+	// and leading dimensions passed on, which must fit the int arguments of CBLAS
+	template<typename T, typename Policy, typename... Dims>
+	[[nodiscard]] bool UseBlas(Policy, size_t work, size_t minWork, Dims... dims)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if constexpr (IS_BLAS_CANDIDATE<T, Policy>)
+		{
+			return work >= minWork && IsBlasEnabled() && ((static_cast<size_t>(dims) <= static_cast<size_t>(INT_MAX)) && ...);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	//================================================================//
+	// Row-major wrappers of the CBLAS routines. They are only called //
+	// after UseBlas, so without SEPOLIA4_USE_CBLAS they do nothing.  //
+	//================================================================//
+
+	// C = alpha * A * B + beta * C, with A m x k, B k x n and C m x n
+	template<typename T>
+	void BlasGemm(size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb,
+			T beta, T* c, size_t ldc)
+	{
+#ifdef SEPOLIA4_USE_CBLAS
+		const auto M = static_cast<int>(m);
+		const auto N = static_cast<int>(n);
+		const auto K = static_cast<int>(k);
+		if constexpr (std::is_same_v<T, double>)
+		{
+			cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, alpha, a, static_cast<int>(lda),
+					b, static_cast<int>(ldb), beta, c, static_cast<int>(ldc));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, alpha, a, static_cast<int>(lda),
+					b, static_cast<int>(ldb), beta, c, static_cast<int>(ldc));
+		}
+#endif
+	}
+
+	// y = alpha * op(A) * x + beta * y, with A m x n and op(A) = A or its transpose
+	template<typename T>
+	void BlasGemv(bool transpose, size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, size_t incx,
+			T beta, T* y, size_t incy)
+	{
+#ifdef SEPOLIA4_USE_CBLAS
+		const auto trans = transpose ? CblasTrans : CblasNoTrans;
+		if constexpr (std::is_same_v<T, double>)
+		{
+			cblas_dgemv(CblasRowMajor, trans, static_cast<int>(m), static_cast<int>(n), alpha, a, static_cast<int>(lda),
+					x, static_cast<int>(incx), beta, y, static_cast<int>(incy));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			cblas_sgemv(CblasRowMajor, trans, static_cast<int>(m), static_cast<int>(n), alpha, a, static_cast<int>(lda),
+					x, static_cast<int>(incx), beta, y, static_cast<int>(incy));
+		}
+#endif
+	}
+
+	// y += alpha * x
+	template<typename T>
+	void BlasAxpy(size_t n, T alpha, const T* x, size_t incx, T* y, size_t incy)
+	{
+#ifdef SEPOLIA4_USE_CBLAS
+		if constexpr (std::is_same_v<T, double>)
+		{
+			cblas_daxpy(static_cast<int>(n), alpha, x, static_cast<int>(incx), y, static_cast<int>(incy));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			cblas_saxpy(static_cast<int>(n), alpha, x, static_cast<int>(incx), y, static_cast<int>(incy));
+		}
+#endif
+	}
+
+	template<typename T>
+	[[nodiscard]] T BlasDot(size_t n, const T* x, size_t incx, const T* y, size_t incy)
+	{
+#ifdef SEPOLIA4_USE_CBLAS
+		if constexpr (std::is_same_v<T, double>)
+		{
+			return cblas_ddot(static_cast<int>(n), x, static_cast<int>(incx), y, static_cast<int>(incy));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			return cblas_sdot(static_cast<int>(n), x, static_cast<int>(incx), y, static_cast<int>(incy));
+		}
+#endif
+		return T(0);
+	}
+
+	// x *= alpha
+	template<typename T>
+	void BlasScal(size_t n, T alpha, T* x, size_t incx)
+	{
+#ifdef SEPOLIA4_USE_CBLAS
+		if constexpr (std::is_same_v<T, double>)
+		{
+			cblas_dscal(static_cast<int>(n), alpha, x, static_cast<int>(incx));
+		}
+		else if constexpr (std::is_same_v<T, float>)
+		{
+			cblas_sscal(static_cast<int>(n), alpha, x, static_cast<int>(incx));
+		}
+#endif
+	}
+}
@@ -0,0 +1,595 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "SimdKernels.h"
+#include "ParallelKernels.h"
+#include "../Execution/ExecutionPolicy.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../../Utilities/CpuFeatures.h"
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//==================================================================//
+	// Matrix product C = alpha * A * B + beta * C on row-major arrays  //
+	// with leading dimensions, blocked as in GotoBLAS / BLIS:          //
+	//  - B is split in KC x NC blocks, packed into NR-wide column      //
+	//    panels that stay in the L3 cache,                             //
+	//  - A is split in MC x KC blocks, packed into MR-high row panels  //
+	//    that stay in the L2 cache,                                    //
+	//  - a register-blocked micro-kernel multiplies one MR x KC panel  //
+	//    of A by one KC x NR panel of B (the latter in the L1 cache)   //
+	//    into an MR x NR tile of C held in vector registers.           //
+	// KC, MC and NC follow from the cache sizes of the running CPU and //
+	// MR x NR from the instruction set the kernels dispatch to.        //
+	//==================================================================//
+
+	struct GemmBlocking
+	{
+		size_t mc;
+		size_t kc;
+		size_t nc;
+	};
+
+	// each operand block takes about half of its cache level, leaving room for the rest of the working set
+	template<typename T, typename Kernel>
+	GemmBlocking ComputeGemmBlocking()
+	{
+		const size_t l1 = UTILITIES::CpuFeatures::GetCacheSize(1);
+		const size_t l2 = UTILITIES::CpuFeatures::GetCacheSize(2);
+		const size_t l3 = UTILITIES::CpuFeatures::GetCacheSize(3);
+
+		size_t kc = l1 / 2 / (Kernel::NR * sizeof(T));
+		kc = std::clamp<size_t>(kc / 16 * 16, 64, 512);
+
+		size_t mc = l2 / 2 / (kc * sizeof(T));
+		mc = std::clamp<size_t>(mc / Kernel::MR * Kernel::MR, Kernel::MR, 64 * Kernel::MR);
+
+		size_t nc = l3 / 2 / (kc * sizeof(T));
+		nc = std::clamp<size_t>(nc / Kernel::NR * Kernel::NR, Kernel::NR, 4096 / Kernel::NR * Kernel::NR);
+
+		return { mc, kc, nc };
+	}
+
+	//=========================//
+	// Portable scalar kernels //
+	//=========================//
+
+	template<size_t MR, size_t NR, typename T>
+	void MicroKernelScalar(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+	{
+		T acc[MR][NR] = {};
+		for (size_t p = 0; p < kc; p++)
+		{
+			for (size_t r = 0; r < MR; r++)
+			{
+				const T ar = a[r];
+				for (size_t j = 0; j < NR; j++)
+				{
+					acc[r][j] += ar * b[j];
+				}
+			}
+			a += MR;
+			b += NR;
+		}
+
+		for (size_t r = 0; r < MR; r++)
+		{
+			for (size_t j = 0; j < NR; j++)
+			{
+				c[r * ldc + j] += acc[r][j];
+			}
+		}
+	}
+
+	template<typename T>
+	struct GemmKernelScalar
+	{
+		static constexpr size_t MR = 4;
+		static constexpr size_t NR = 4;
+
+		static void Run(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+		{
+			MicroKernelScalar<MR, NR>(kc, a, b, c, ldc);
+		}
+	};
+
+#ifdef SEPOLIA4_X86_SIMD
+
+	//=========================================================//
+	// SIMD micro-kernels: per step of k, NV vectors of B are  //
+	// loaded once and multiplied by MR broadcast values of A  //
+	// into MR x NV accumulators, which never leave registers. //
+	//=========================================================//
+
+	__attribute__((target("sse2"))) inline __m128d MulAddSse2(__m128d a, __m128d b, __m128d c)
+	{
+		return _mm_add_pd(_mm_mul_pd(a, b), c);
+	}
+
+	__attribute__((target("sse2"))) inline __m128 MulAddSse2(__m128 a, __m128 b, __m128 c)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+	__attribute__((target("avx2,fma"))) inline __m256d MulAddAvx2(__m256d a, __m256d b, __m256d c)
+	{
+		return _mm256_fmadd_pd(a, b, c);
+	}
+
+	__attribute__((target("avx2,fma"))) inline __m256 MulAddAvx2(__m256 a, __m256 b, __m256 c)
+	{
+		return _mm256_fmadd_ps(a, b, c);
+	}
+
+	__attribute__((target("avx512f"))) inline __m512d MulAddAvx512(__m512d a, __m512d b, __m512d c)
+	{
+		return _mm512_fmadd_pd(a, b, c);
+	}
+
+	__attribute__((target("avx512f"))) inline __m512 MulAddAvx512(__m512 a, __m512 b, __m512 c)
+	{
+		return _mm512_fmadd_ps(a, b, c);
+	}
+
+	template<size_t MR, size_t NV, typename T>
+	__attribute__((target("sse2"))) void MicroKernelSse2(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		using V = decltype(LoadSse2(b));
+		V acc[MR][NV];
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				acc[r][v] = BroadcastSse2(T(0));
+			}
+		}
+
+		for (size_t p = 0; p < kc; p++)
+		{
+			V bv[NV];
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				bv[v] = LoadSse2(b + v * LANES);
+			}
+#pragma GCC unroll 16
+			for (size_t r = 0; r < MR; r++)
+			{
+				const V ar = BroadcastSse2(a[r]);
+#pragma GCC unroll 4
+				for (size_t v = 0; v < NV; v++)
+				{
+					acc[r][v] = MulAddSse2(ar, bv[v], acc[r][v]);
+				}
+			}
+			a += MR;
+			b += NV * LANES;
+		}
+
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				T* const cr = c + r * ldc + v * LANES;
+				StoreSse2(cr, ApplySse2<OPERATIONS::Plus>(LoadSse2(cr), acc[r][v]));
+			}
+		}
+	}
+
+	template<size_t MR, size_t NV, typename T>
+	__attribute__((target("avx2,fma"))) void MicroKernelAvx2(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		using V = decltype(LoadAvx2(b));
+		V acc[MR][NV];
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				acc[r][v] = BroadcastAvx2(T(0));
+			}
+		}
+
+		for (size_t p = 0; p < kc; p++)
+		{
+			V bv[NV];
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				bv[v] = LoadAvx2(b + v * LANES);
+			}
+#pragma GCC unroll 16
+			for (size_t r = 0; r < MR; r++)
+			{
+				const V ar = BroadcastAvx2(a[r]);
+#pragma GCC unroll 4
+				for (size_t v = 0; v < NV; v++)
+				{
+					acc[r][v] = MulAddAvx2(ar, bv[v], acc[r][v]);
+				}
+			}
+			a += MR;
+			b += NV * LANES;
+		}
+
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				T* const cr = c + r * ldc + v * LANES;
+				StoreAvx2(cr, ApplyAvx2<OPERATIONS::Plus>(LoadAvx2(cr), acc[r][v]));
+			}
+		}
+	}
+
+	template<size_t MR, size_t NV, typename T>
+	__attribute__((target("avx512f"))) void MicroKernelAvx512(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		using V = decltype(LoadAvx512(b));
+		V acc[MR][NV];
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				acc[r][v] = BroadcastAvx512(T(0));
+			}
+		}
+
+		for (size_t p = 0; p < kc; p++)
+		{
+			V bv[NV];
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				bv[v] = LoadAvx512(b + v * LANES);
+			}
+#pragma GCC unroll 16
+			for (size_t r = 0; r < MR; r++)
+			{
+				const V ar = BroadcastAvx512(a[r]);
+#pragma GCC unroll 4
+				for (size_t v = 0; v < NV; v++)
+				{
+					acc[r][v] = MulAddAvx512(ar, bv[v], acc[r][v]);
+				}
+			}
+			a += MR;
+			b += NV * LANES;
+		}
+
+#pragma GCC unroll 16
+		for (size_t r = 0; r < MR; r++)
+		{
+#pragma GCC unroll 4
+			for (size_t v = 0; v < NV; v++)
+			{
+				T* const cr = c + r * ldc + v * LANES;
+				StoreAvx512(cr, ApplyAvx512<OPERATIONS::Plus>(LoadAvx512(cr), acc[r][v]));
+			}
+		}
+	}
+
+	// register tiles: 8 (SSE2), 12 (AVX2) and 24 (AVX-512) accumulators, out of 16, 16 and 32 vector registers
+
+	template<typename T>
+	struct GemmKernelSse2
+	{
+		static constexpr size_t MR = 4;
+		static constexpr size_t NR = 2 * 16 / sizeof(T);
+
+		static void Run(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+		{
+			MicroKernelSse2<MR, 2>(kc, a, b, c, ldc);
+		}
+	};
+
+	template<typename T>
+	struct GemmKernelAvx2
+	{
+		static constexpr size_t MR = 6;
+		static constexpr size_t NR = 2 * 32 / sizeof(T);
+
+		static void Run(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+		{
+			MicroKernelAvx2<MR, 2>(kc, a, b, c, ldc);
+		}
+	};
+
+	template<typename T>
+	struct GemmKernelAvx512
+	{
+		static constexpr size_t MR = 8;
+		static constexpr size_t NR = 3 * 64 / sizeof(T);
+
+		static void Run(size_t kc, const T* a, const T* b, T* c, size_t ldc)
+		{
+			MicroKernelAvx512<MR, 3>(kc, a, b, c, ldc);
+		}
+	};
+
+#endif
+
+	//=========//
+	// Packing //
+	//=========//
+
+	// alpha * A(0:mc, 0:kc) into panels of MR rows: element (i0 + r, p) of panel i0 at [p * MR + r], zero-padded
+	template<size_t MR, typename T>
+	void PackA(size_t mc, size_t kc, T alpha, const T* a, size_t lda, T* packed)
+	{
+		for (size_t i0 = 0; i0 < mc; i0 += MR)
+		{
+			const size_t mr = std::min(MR, mc - i0);
+			for (size_t p = 0; p < kc; p++)
+			{
+				for (size_t r = 0; r < mr; r++)
+				{
+					packed[r] = alpha * a[(i0 + r) * lda + p];
+				}
+				for (size_t r = mr; r < MR; r++)
+				{
+					packed[r] = T(0);
+				}
+				packed += MR;
+			}
+		}
+	}
+
+	// B(0:kc, 0:nc) into panels of NR columns: element (p, j0 + j) of panel j0 at [p * NR + j], zero-padded
+	template<size_t NR, typename T>
+	void PackB(size_t kc, size_t nc, const T* b, size_t ldb, T* packed)
+	{
+		for (size_t j0 = 0; j0 < nc; j0 += NR)
+		{
+			const size_t nr = std::min(NR, nc - j0);
+			for (size_t p = 0; p < kc; p++)
+			{
+				const T* const row = b + p * ldb + j0;
+				for (size_t j = 0; j < nr; j++)
+				{
+					packed[j] = row[j];
+				}
+				for (size_t j = nr; j < NR; j++)
+				{
+					packed[j] = T(0);
+				}
+				packed += NR;
+			}
+		}
+	}
+
+	//===================================================================//
+	// Per-thread packing buffers, kept between calls so that repeated   //
+	// products do not allocate. A thread that waits for its tasks runs  //
+	// other pending tasks, possibly another product that wants the same //
+	// buffer while the waiting call still holds it: the buffer is taken //
+	// for the lifetime of the object, and a nested user gets storage of //
+	// its own instead.                                                  //
+	//===================================================================//
+
+	template<typename T, int ID>
+	class ScopedPackingBuffer final
+	{
+	public:
+
+		explicit ScopedPackingBuffer(size_t size)
+		{
+			State& state = ThreadState();
+			if (state.inUse)
+			{
+				m_own.resize(size);
+				m_data = m_own.data();
+				return;
+			}
+			if (state.buffer.size() < size) state.buffer.resize(size);
+			state.inUse = true;
+			m_state = &state;
+			m_data = state.buffer.data();
+		}
+
+		ScopedPackingBuffer(const ScopedPackingBuffer&) = delete;
+
+		ScopedPackingBuffer& operator=(const ScopedPackingBuffer&) = delete;
+
+		~ScopedPackingBuffer()
+		{
+			if (m_state) m_state->inUse = false;
+		}
+
+		[[nodiscard]] T* Data() const
+		{
+			return m_data;
+		}
+
+	private:
+
+		struct State
+		{
+			std::vector<T, AlignedAllocator<T>> buffer;
+			bool inUse = false;
+		};
+
+		static State& ThreadState()
+		{
+			thread_local State state;
+			return state;
+		}
+
+		State* m_state = nullptr;
+		T* m_data = nullptr;
+		std::vector<T, AlignedAllocator<T>> m_own;
+	};
+
+	//==============//
+	// Blocked GEMM //
+	//==============//
+
+	// C(0:mc, 0:nc) += packed A block * packed B block, the edge tiles through a zero-padded buffer
+	template<typename Kernel, typename T>
+	void GemmMacroKernel(size_t mc, size_t nc, size_t kc, const T* packedA, const T* packedB, T* c, size_t ldc)
+	{
+		constexpr size_t MR = Kernel::MR;
+		constexpr size_t NR = Kernel::NR;
+		for (size_t jr = 0; jr < nc; jr += NR)
+		{
+			const size_t nr = std::min(NR, nc - jr);
+			for (size_t ir = 0; ir < mc; ir += MR)
+			{
+				const size_t mr = std::min(MR, mc - ir);
+				T* const tile = c + ir * ldc + jr;
+				if (mr == MR && nr == NR)
+				{
+					Kernel::Run(kc, packedA + ir * kc, packedB + jr * kc, tile, ldc);
+					continue;
+				}
+
+				T edge[MR * NR] = {};
+				Kernel::Run(kc, packedA + ir * kc, packedB + jr * kc, edge, NR);
+				for (size_t r = 0; r < mr; r++)
+				{
+					for (size_t j = 0; j < nr; j++)
+					{
+						tile[r * ldc + j] += edge[r * NR + j];
+					}
+				}
+			}
+		}
+	}
+
+	// from this m * n * k on (a product of two 128 x 128 matrices) the threads share the work
+	constexpr size_t GEMM_PARALLEL_MIN_SIZE = size_t(1) << 21;
+
+	// tiles of C per thread in each NC x KC step, so that the work-stealing pool can even out the load
+	constexpr size_t GEMM_TILES_PER_THREAD = 2;
+
+	//====================================================================//
+	// Threaded GEMM: per NC x KC step, the threads first pack the panels //
+	// of B together into one shared buffer, then split the m x nc panel  //
+	// of C into a 2D grid of tiles: MC rows (a block of A, packed by     //
+	// each thread into its own buffer) by a range of NR-wide columns.    //
+	// The columns are split only when there are too few row blocks for   //
+	// the threads. No two tiles overlap, so C needs no synchronization.  //
+	//====================================================================//
+
+	template<typename Kernel, typename T>
+	void GemmBlocked(size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+			size_t numThreads = 1)
+	{
+		constexpr size_t MR = Kernel::MR;
+		constexpr size_t NR = Kernel::NR;
+		const auto blocking = ComputeGemmBlocking<T, Kernel>();
+		const size_t kcMax = std::min(blocking.kc, k);
+		const size_t mcMax = std::min(blocking.mc, (m + MR - 1) / MR * MR);
+		const size_t ncMax = std::min(blocking.nc, (n + NR - 1) / NR * NR);
+		const ScopedPackingBuffer<T, 1> packedBBuffer(kcMax * ncMax);
+		T* const packedB = packedBBuffer.Data();
+
+		const size_t rowBlocks = (m + blocking.mc - 1) / blocking.mc;
+		for (size_t jc = 0; jc < n; jc += blocking.nc)
+		{
+			const size_t nc = std::min(blocking.nc, n - jc);
+			const size_t panels = (nc + NR - 1) / NR;
+			const size_t targetTiles = numThreads > 1 ? GEMM_TILES_PER_THREAD * numThreads : 1;
+			const size_t colBlocks = std::clamp<size_t>((targetTiles + rowBlocks - 1) / rowBlocks, 1, panels);
+			for (size_t pc = 0; pc < k; pc += blocking.kc)
+			{
+				const size_t kc = std::min(blocking.kc, k - pc);
+				UTILITIES::ParallelForChunks(panels, numThreads, 1, [=](size_t, size_t begin, size_t end)
+				{
+					PackB<NR>(kc, std::min(end * NR, nc) - begin * NR, b + pc * ldb + jc + begin * NR, ldb,
+							packedB + begin * NR * kc);
+				});
+
+				UTILITIES::ParallelForChunks(rowBlocks * colBlocks, numThreads, 1, [=](size_t, size_t begin, size_t end)
+				{
+					const ScopedPackingBuffer<T, 0> packedABuffer(mcMax * kcMax);
+					T* const packedA = packedABuffer.Data();
+					size_t packedRowBlock = rowBlocks;
+					for (size_t tile = begin; tile < end; tile++)
+					{
+						const size_t rowBlock = tile / colBlocks;
+						const size_t colBlock = tile % colBlocks;
+						const size_t ic = rowBlock * blocking.mc;
+						const size_t mc = std::min(blocking.mc, m - ic);
+						if (rowBlock != packedRowBlock)
+						{
+							PackA<MR>(mc, kc, alpha, a + ic * lda + pc, lda, packedA);
+							packedRowBlock = rowBlock;
+						}
+						const size_t jr = colBlock * panels / colBlocks * NR;
+						const size_t jrEnd = std::min((colBlock + 1) * panels / colBlocks * NR, nc);
+						GemmMacroKernel<Kernel>(mc, jrEnd - jr, kc, packedA, packedB + jr * kc, c + ic * ldc + jc + jr, ldc);
+					}
+				});
+			}
+		}
+	}
+
+	// C(0:m, 0:n) = beta * C, without reading C when beta is 0
+	template<typename T, typename Policy>
+	void ScaleRows(Policy policy, size_t m, size_t n, T beta, T* c, size_t ldc)
+	{
+		if (beta == T(1)) return;
+		ForRows<T>(policy, m, n, [=](size_t beginRow, size_t endRow)
+		{
+			for (size_t i = beginRow; i < endRow; i++)
+			{
+				T* const row = c + i * ldc;
+				if (beta == T(0)) std::fill_n(row, n, T(0));
+				else for (size_t j = 0; j < n; j++) row[j] *= beta;
+			}
+		});
+	}
+
+	// number of threads a product of the given size runs on under the policy
+	template<typename Policy>
+	[[nodiscard]] size_t GemmNumThreads(Policy, size_t m, size_t n, size_t k)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if constexpr (Policy::PARALLEL) return m * n * k >= GEMM_PARALLEL_MIN_SIZE ? UTILITIES::GetNumThreads() : 1;
+		else return 1;
+	}
+
+	// C = alpha * A * B + beta * C, with A m x k, B k x n and C m x n, all row-major; C must not overlap A or B.
+	// Large products run on the worker threads under parallel policies; policies that are not VECTORIZED
+	// run the portable scalar micro-kernel.
+	template<typename T, typename Policy>
+	void Gemm(Policy policy, size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb,
+			T beta, T* c, size_t ldc)
+	{
+		ScaleRows(policy, m, n, beta, c, ldc);
+		if (m == 0 || n == 0 || k == 0 || alpha == T(0)) return;
+		const size_t numThreads = GemmNumThreads(policy, m, n, k);
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return GemmBlocked<GemmKernelAvx512<T>>(m, n, k, alpha, a, lda, b, ldb, c, ldc, numThreads);
+				case UTILITIES::SimdLevel::AVX2:
+					return GemmBlocked<GemmKernelAvx2<T>>(m, n, k, alpha, a, lda, b, ldb, c, ldc, numThreads);
+				case UTILITIES::SimdLevel::SSE2:
+					return GemmBlocked<GemmKernelSse2<T>>(m, n, k, alpha, a, lda, b, ldb, c, ldc, numThreads);
+				default:
+					break;
+			}
+		}
+#endif
+		GemmBlocked<GemmKernelScalar<T>>(m, n, k, alpha, a, lda, b, ldb, c, ldc, numThreads);
+	}
+}
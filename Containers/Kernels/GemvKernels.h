@@ -0,0 +1,361 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "SimdKernels.h"
+#include "ReductionKernels.h"
+#include "ParallelKernels.h"
+#include "GemmKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	// which matrix Gemv multiplies the vector with
+	enum class Transpose
+	{
+		NO,     // y = alpha * A * x + beta * y
+		YES     // y = alpha * A^T * x + beta * y
+	};
+}
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//=================================================================//
+	// Matrix-vector product on a row-major A with a leading           //
+	// dimension. A * x is a dot product per row of A: the kernels     //
+	// run four rows at a time, so each load of x feeds four FMAs and  //
+	// the four accumulators hide the latency of the additions.        //
+	// A^T * x adds x[i] times row i of A into y: the kernels add four //
+	// rows at a time, in column blocks of y that stay in the L1       //
+	// cache. Threads split the rows of A for A * x and the columns of //
+	// A for A^T * x, so no two threads write the same element of y.   //
+	//=================================================================//
+
+	constexpr size_t GEMV_ROWS = 4;
+
+	// elements of y per column block of A^T * x (8 KiB)
+	template<typename T>
+	constexpr size_t GEMV_COLUMN_BLOCK = (size_t(1) << 13) / sizeof(T);
+
+	// y = alpha * dot + beta * y, without reading y when beta is 0 (as BLAS)
+	template<typename T>
+	inline void GemvUpdate(T& y, T alpha, T dot, T beta)
+	{
+		y = beta == T(0) ? alpha * dot : alpha * dot + beta * y;
+	}
+
+	//=========================//
+	// Portable scalar kernels //
+	//=========================//
+
+	// y[j] += s[0] * a[j] + s[1] * a[lda + j] + s[2] * a[2 * lda + j] + s[3] * a[3 * lda + j] for j in [begin, end)
+	template<typename T>
+	void Axpy4Scalar(const T* a, size_t lda, const T* s, T* y, size_t begin, size_t end)
+	{
+		for (size_t j = begin; j < end; j++)
+		{
+			y[j] += s[0] * a[j] + s[1] * a[lda + j] + s[2] * a[2 * lda + j] + s[3] * a[3 * lda + j];
+		}
+	}
+
+#ifdef SEPOLIA4_X86_SIMD
+
+	//======//
+	// SSE2 //
+	//======//
+
+	// out[r] = dot product of row r of a with x, for the four rows r
+	template<typename T>
+	__attribute__((target("sse2"))) void Dot4Sse2(const T* a, size_t lda, const T* x, size_t n, T* out)
+	{
+		using Plus = OPERATIONS::Plus;
+		constexpr size_t LANES = 16 / sizeof(T);
+		auto acc0 = BroadcastSse2(T(0));
+		auto acc1 = acc0;
+		auto acc2 = acc0;
+		auto acc3 = acc0;
+		size_t j = 0;
+		for (; j + LANES <= n; j += LANES)
+		{
+			const auto xv = LoadSse2(x + j);
+			acc0 = MulAddSse2(LoadSse2(a + j), xv, acc0);
+			acc1 = MulAddSse2(LoadSse2(a + lda + j), xv, acc1);
+			acc2 = MulAddSse2(LoadSse2(a + 2 * lda + j), xv, acc2);
+			acc3 = MulAddSse2(LoadSse2(a + 3 * lda + j), xv, acc3);
+		}
+		out[0] = DotScalar(a, x, j, n, HorizontalSse2<Plus, T>(acc0));
+		out[1] = DotScalar(a + lda, x, j, n, HorizontalSse2<Plus, T>(acc1));
+		out[2] = DotScalar(a + 2 * lda, x, j, n, HorizontalSse2<Plus, T>(acc2));
+		out[3] = DotScalar(a + 3 * lda, x, j, n, HorizontalSse2<Plus, T>(acc3));
+	}
+
+	template<typename T>
+	__attribute__((target("sse2"))) void Axpy4Sse2(const T* a, size_t lda, const T* s, T* y, size_t begin, size_t end)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		const auto s0 = BroadcastSse2(s[0]);
+		const auto s1 = BroadcastSse2(s[1]);
+		const auto s2 = BroadcastSse2(s[2]);
+		const auto s3 = BroadcastSse2(s[3]);
+		size_t j = begin;
+		for (; j + LANES <= end; j += LANES)
+		{
+			auto yv = LoadSse2(y + j);
+			yv = MulAddSse2(s0, LoadSse2(a + j), yv);
+			yv = MulAddSse2(s1, LoadSse2(a + lda + j), yv);
+			yv = MulAddSse2(s2, LoadSse2(a + 2 * lda + j), yv);
+			yv = MulAddSse2(s3, LoadSse2(a + 3 * lda + j), yv);
+			StoreSse2(y + j, yv);
+		}
+		Axpy4Scalar(a, lda, s, y, j, end);
+	}
+
+	//======//
+	// AVX2 //
+	//======//
+
+	template<typename T>
+	__attribute__((target("avx2,fma"))) void Dot4Avx2(const T* a, size_t lda, const T* x, size_t n, T* out)
+	{
+		using Plus = OPERATIONS::Plus;
+		constexpr size_t LANES = 32 / sizeof(T);
+		auto acc0 = BroadcastAvx2(T(0));
+		auto acc1 = acc0;
+		auto acc2 = acc0;
+		auto acc3 = acc0;
+		size_t j = 0;
+		for (; j + LANES <= n; j += LANES)
+		{
+			const auto xv = LoadAvx2(x + j);
+			acc0 = MulAddAvx2(LoadAvx2(a + j), xv, acc0);
+			acc1 = MulAddAvx2(LoadAvx2(a + lda + j), xv, acc1);
+			acc2 = MulAddAvx2(LoadAvx2(a + 2 * lda + j), xv, acc2);
+			acc3 = MulAddAvx2(LoadAvx2(a + 3 * lda + j), xv, acc3);
+		}
+		out[0] = DotScalar(a, x, j, n, HorizontalAvx2<Plus, T>(acc0));
+		out[1] = DotScalar(a + lda, x, j, n, HorizontalAvx2<Plus, T>(acc1));
+		out[2] = DotScalar(a + 2 * lda, x, j, n, HorizontalAvx2<Plus, T>(acc2));
+		out[3] = DotScalar(a + 3 * lda, x, j, n, HorizontalAvx2<Plus, T>(acc3));
+	}
+
+	template<typename T>
+	__attribute__((target("avx2,fma"))) void Axpy4Avx2(const T* a, size_t lda, const T* s, T* y, size_t begin, size_t end)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		const auto s0 = BroadcastAvx2(s[0]);
+		const auto s1 = BroadcastAvx2(s[1]);
+		const auto s2 = BroadcastAvx2(s[2]);
+		const auto s3 = BroadcastAvx2(s[3]);
+		size_t j = begin;
+		for (; j + LANES <= end; j += LANES)
+		{
+			auto yv = LoadAvx2(y + j);
+			yv = MulAddAvx2(s0, LoadAvx2(a + j), yv);
+			yv = MulAddAvx2(s1, LoadAvx2(a + lda + j), yv);
+			yv = MulAddAvx2(s2, LoadAvx2(a + 2 * lda + j), yv);
+			yv = MulAddAvx2(s3, LoadAvx2(a + 3 * lda + j), yv);
+			StoreAvx2(y + j, yv);
+		}
+		Axpy4Scalar(a, lda, s, y, j, end);
+	}
+
+	//=========//
+	// AVX-512 //
+	//=========//
+
+	template<typename T>
+	__attribute__((target("avx512f"))) void Dot4Avx512(const T* a, size_t lda, const T* x, size_t n, T* out)
+	{
+		using Plus = OPERATIONS::Plus;
+		constexpr size_t LANES = 64 / sizeof(T);
+		auto acc0 = BroadcastAvx512(T(0));
+		auto acc1 = acc0;
+		auto acc2 = acc0;
+		auto acc3 = acc0;
+		size_t j = 0;
+		for (; j + LANES <= n; j += LANES)
+		{
+			const auto xv = LoadAvx512(x + j);
+			acc0 = MulAddAvx512(LoadAvx512(a + j), xv, acc0);
+			acc1 = MulAddAvx512(LoadAvx512(a + lda + j), xv, acc1);
+			acc2 = MulAddAvx512(LoadAvx512(a + 2 * lda + j), xv, acc2);
+			acc3 = MulAddAvx512(LoadAvx512(a + 3 * lda + j), xv, acc3);
+		}
+		out[0] = DotScalar(a, x, j, n, HorizontalAvx512<Plus, T>(acc0));
+		out[1] = DotScalar(a + lda, x, j, n, HorizontalAvx512<Plus, T>(acc1));
+		out[2] = DotScalar(a + 2 * lda, x, j, n, HorizontalAvx512<Plus, T>(acc2));
+		out[3] = DotScalar(a + 3 * lda, x, j, n, HorizontalAvx512<Plus, T>(acc3));
+	}
+
+	template<typename T>
+	__attribute__((target("avx512f"))) void Axpy4Avx512(const T* a, size_t lda, const T* s, T* y, size_t begin, size_t end)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		const auto s0 = BroadcastAvx512(s[0]);
+		const auto s1 = BroadcastAvx512(s[1]);
+		const auto s2 = BroadcastAvx512(s[2]);
+		const auto s3 = BroadcastAvx512(s[3]);
+		size_t j = begin;
+		for (; j + LANES <= end; j += LANES)
+		{
+			auto yv = LoadAvx512(y + j);
+			yv = MulAddAvx512(s0, LoadAvx512(a + j), yv);
+			yv = MulAddAvx512(s1, LoadAvx512(a + lda + j), yv);
+			yv = MulAddAvx512(s2, LoadAvx512(a + 2 * lda + j), yv);
+			yv = MulAddAvx512(s3, LoadAvx512(a + 3 * lda + j), yv);
+			StoreAvx512(y + j, yv);
+		}
+		Axpy4Scalar(a, lda, s, y, j, end);
+	}
+
+#endif
+
+	//================================================================//
+	// Dispatchers on rows [beginRow, endRow) of A * x, which reads x //
+	// contiguously, and on columns [begin, end) of A^T * x, which    //
+	// writes y contiguously. Policies that are not VECTORIZED run    //
+	// the portable scalar loops.                                     //
+	//================================================================//
+
+	template<typename Policy, typename T>
+	void GemvRows(Policy policy, size_t beginRow, size_t endRow, size_t n, T alpha, const T* a, size_t lda,
+			const T* x, T beta, T* y, size_t incy)
+	{
+		size_t i = beginRow;
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			const auto level = UTILITIES::CpuFeatures::GetSimdLevel();
+			T dots[GEMV_ROWS];
+			for (; level != UTILITIES::SimdLevel::SCALAR && i + GEMV_ROWS <= endRow; i += GEMV_ROWS)
+			{
+				const T* const rows = a + i * lda;
+				switch (level)
+				{
+					case UTILITIES::SimdLevel::AVX512:
+						Dot4Avx512(rows, lda, x, n, dots);
+						break;
+					case UTILITIES::SimdLevel::AVX2:
+						Dot4Avx2(rows, lda, x, n, dots);
+						break;
+					default:
+						Dot4Sse2(rows, lda, x, n, dots);
+						break;
+				}
+				for (size_t r = 0; r < GEMV_ROWS; r++)
+				{
+					GemvUpdate(y[(i + r) * incy], alpha, dots[r], beta);
+				}
+			}
+		}
+#endif
+		for (; i < endRow; i++)
+		{
+			GemvUpdate(y[i * incy], alpha, Dot(policy, a + i * lda, x, n), beta);
+		}
+	}
+
+	template<typename Policy, typename T>
+	void GemvTransposedColumns(Policy, size_t begin, size_t end, size_t m, T alpha, const T* a, size_t lda,
+			const T* x, size_t incx, T beta, T* y)
+	{
+		auto axpy4 = &Axpy4Scalar<T>;
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					axpy4 = &Axpy4Avx512<T>;
+					break;
+				case UTILITIES::SimdLevel::AVX2:
+					axpy4 = &Axpy4Avx2<T>;
+					break;
+				case UTILITIES::SimdLevel::SSE2:
+					axpy4 = &Axpy4Sse2<T>;
+					break;
+				default:
+					break;
+			}
+		}
+#endif
+		for (size_t jb = begin; jb < end; jb += GEMV_COLUMN_BLOCK<T>)
+		{
+			const size_t je = std::min(end, jb + GEMV_COLUMN_BLOCK<T>);
+			for (size_t j = jb; j < je; j++)
+			{
+				y[j] = beta == T(0) ? T(0) : beta * y[j];
+			}
+			size_t i = 0;
+			for (; i + GEMV_ROWS <= m; i += GEMV_ROWS)
+			{
+				const T s[GEMV_ROWS] = { alpha * x[i * incx], alpha * x[(i + 1) * incx],
+										 alpha * x[(i + 2) * incx], alpha * x[(i + 3) * incx] };
+				axpy4(a + i * lda, lda, s, y, jb, je);
+			}
+			for (; i < m; i++)
+			{
+				const T s = alpha * x[i * incx];
+				const T* const row = a + i * lda;
+				for (size_t j = jb; j < je; j++)
+				{
+					y[j] += s * row[j];
+				}
+			}
+		}
+	}
+
+	// y = alpha * op(A) * x + beta * y with A m x n row-major, op(A) = A or A^T,
+	// x and y strided; y must not overlap A or x. Large products run on the worker
+	// threads under parallel policies.
+	template<typename T, typename Policy>
+	void Gemv(Policy policy, Transpose transpose, size_t m, size_t n, T alpha, const T* a, size_t lda,
+			const T* x, size_t incx, T beta, T* y, size_t incy)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if (transpose == Transpose::NO)
+		{
+			// the row dot kernels read x contiguously: gather a strided x once
+			const ScopedPackingBuffer<T, 2> gathered(incx != 1 ? n : 0);
+			if (incx != 1)
+			{
+				T* const packed = gathered.Data();
+				for (size_t j = 0; j < n; j++)
+				{
+					packed[j] = x[j * incx];
+				}
+				x = packed;
+			}
+			ForRows<T>(policy, m, n, [=](size_t beginRow, size_t endRow)
+			{
+				GemvRows(policy, beginRow, endRow, n, alpha, a, lda, x, beta, y, incy);
+			});
+		}
+		else
+		{
+			// the column blocks are updated in place: a strided y goes through a contiguous copy
+			const ScopedPackingBuffer<T, 3> copy(incy != 1 ? n : 0);
+			T* out = y;
+			if (incy != 1)
+			{
+				out = copy.Data();
+				for (size_t j = 0; j < n; j++)
+				{
+					out[j] = y[j * incy];
+				}
+			}
+			const auto body = [=](size_t begin, size_t end)
+			{
+				GemvTransposedColumns(policy, begin, end, m, alpha, a, lda, x, incx, beta, out);
+			};
+			if (IsParallel<T>(policy, m * n)) ParallelChunks<T>(n, body);
+			else if (n > 0) body(0, n);
+			if (incy != 1)
+			{
+				for (size_t j = 0; j < n; j++)
+				{
+					y[j * incy] = out[j];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "../Execution/ExecutionPolicy.h"
+#include "../../Utilities/Parallel.h"
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	constexpr size_t PAGE_SIZE = 4096;
+
+	//==================================================================//
+	// Chunk boundaries of the parallel kernels fall on page multiples, //
+	// so each page of a container is first touched and later worked   //
+	// on by the same thread, and no two threads share a cache line    //
+	//==================================================================//
+
+	template<typename T>
+	constexpr size_t PARALLEL_BLOCK_SIZE = PAGE_SIZE / sizeof(T) > 0 ? PAGE_SIZE / sizeof(T) : 1;
+
+	// below this size (256 KiB of elements) waking the workers costs more than the loop itself
+	template<typename T>
+	constexpr size_t PARALLEL_MIN_SIZE = (size_t(1) << 18) / sizeof(T);
+
+	template<typename T, typename F>
+	void ParallelChunks(size_t n, F&& body)
+	{
+		UTILITIES::ParallelFor(n, PARALLEL_BLOCK_SIZE<T>, body);
+	}
+
+	// whether a loop over n elements runs on the worker threads under the given policy
+	template<typename T, typename Policy>
+	[[nodiscard]] bool IsParallel(Policy, size_t n)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if constexpr (Policy::PARALLEL) return n >= PARALLEL_MIN_SIZE<T> && UTILITIES::GetNumThreads() > 1;
+		else return false;
+	}
+
+	// body(begin, end) on the chunks of [0, n) on the worker threads, or on the whole range on the calling thread
+	template<typename T, typename Policy, typename F>
+	void ForChunks(Policy policy, size_t n, F&& body)
+	{
+		if (IsParallel<T>(policy, n)) ParallelChunks<T>(n, body);
+		else if (n > 0) body(0, n);
+	}
+
+	// body(beginRow, endRow) on the chunks of nrows rows of ncols elements, on the worker threads when the whole is large
+	template<typename T, typename Policy, typename F>
+	void ForRows(Policy policy, size_t nrows, size_t ncols, F&& body)
+	{
+		if (IsParallel<T>(policy, nrows * ncols)) UTILITIES::ParallelFor(nrows, 1, body);
+		else if (nrows > 0) body(0, nrows);
+	}
+
+	// results of body(begin, end) on the chunks of [0, n), in chunk order, for the reductions to combine
+	template<typename T, typename F>
+	auto ParallelPartials(size_t n, F&& body)
+	{
+		using R = std::invoke_result_t<F&, size_t, size_t>;
+		std::vector<std::optional<R>> chunks(UTILITIES::GetNumThreads());
+		UTILITIES::ParallelForChunks(n, chunks.size(), PARALLEL_BLOCK_SIZE<T>, [&chunks, &body](size_t chunkIdx, size_t begin, size_t end)
+		{
+			chunks[chunkIdx] = body(begin, end);
+		});
+
+		std::vector<R> partials;
+		partials.reserve(chunks.size());
+		for (auto& chunk: chunks)
+		{
+			if (chunk) partials.push_back(std::move(*chunk));
+		}
+		return partials;
+	}
+}
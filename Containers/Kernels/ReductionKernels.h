@@ -0,0 +1,574 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include "SimdKernels.h"
+#include "ParallelKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	// how Vector::Sum adds the elements up
+	enum class Summation
+	{
+		FAST,       // SIMD multi-accumulator loop, error grows with n
+		KAHAN,      // compensated (Neumaier) summation, error independent of n
+		PAIRWISE    // recursive halving over SIMD blocks, error grows with log(n)
+	};
+}
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//================================================================//
+	// Reductions over contiguous arrays. The SIMD kernels keep four  //
+	// independent accumulators, so consecutive additions do not wait //
+	// on each other, and combine them only at the end. The order of  //
+	// the additions therefore differs from a plain loop: results of  //
+	// floating point sums may differ in the last bits.               //
+	//================================================================//
+
+	constexpr size_t NUM_ACCUMULATORS = 4;
+
+	// blocks summed directly by the pairwise summation
+	constexpr size_t PAIRWISE_BLOCK_SIZE = 256;
+
+	//=========================//
+	// Portable scalar kernels //
+	//=========================//
+
+	template<typename Op, typename T>
+	T ReduceScalar(const T* a, size_t begin, size_t end, T init)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			init = Op::Apply(init, a[i]);
+		}
+		return init;
+	}
+
+	template<typename T>
+	T DotScalar(const T* a, const T* b, size_t begin, size_t end, T init)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			init += a[i] * b[i];
+		}
+		return init;
+	}
+
+	template<typename T>
+	std::pair<T, T> MinMaxScalar(const T* a, size_t begin, size_t end, std::pair<T, T> init)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			init.first = OPERATIONS::Min::Apply(init.first, a[i]);
+			init.second = OPERATIONS::Max::Apply(init.second, a[i]);
+		}
+		return init;
+	}
+
+	//=========================================================//
+	// Strided scalar kernels, element i at a[i * stride]: the //
+	// rows, columns and diagonals seen through a VectorView   //
+	//=========================================================//
+
+	template<typename Op, typename T>
+	T ReduceStrided(const T* a, size_t n, size_t stride, T init)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			init = Op::Apply(init, a[i * stride]);
+		}
+		return init;
+	}
+
+	template<typename T>
+	T DotStrided(const T* a, size_t strideA, const T* b, size_t strideB, size_t n)
+	{
+		T res = T(0);
+		for (size_t i = 0; i < n; i++)
+		{
+			res += a[i * strideA] * b[i * strideB];
+		}
+		return res;
+	}
+
+	template<typename T>
+	std::pair<T, T> MinMaxStrided(const T* a, size_t n, size_t stride)
+	{
+		std::pair<T, T> res{ a[0], a[0] };
+		for (size_t i = 1; i < n; i++)
+		{
+			res.first = OPERATIONS::Min::Apply(res.first, a[i * stride]);
+			res.second = OPERATIONS::Max::Apply(res.second, a[i * stride]);
+		}
+		return res;
+	}
+
+#ifdef SEPOLIA4_X86_SIMD
+
+	//======//
+	// SSE2 //
+	//======//
+
+	template<typename Op, typename T, typename V>
+	__attribute__((target("sse2"))) inline T HorizontalSse2(V x)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		T lanes[LANES];
+		StoreSse2(lanes, x);
+		return ReduceScalar<Op>(lanes, 1, LANES, lanes[0]);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("sse2"))) T ReduceSse2(const T* a, size_t n, T init)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return ReduceScalar<Op>(a, 0, n, init);
+		auto acc0 = LoadSse2(a);
+		auto acc1 = LoadSse2(a + LANES);
+		auto acc2 = LoadSse2(a + 2 * LANES);
+		auto acc3 = LoadSse2(a + 3 * LANES);
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplySse2<Op>(acc0, LoadSse2(a + i));
+			acc1 = ApplySse2<Op>(acc1, LoadSse2(a + i + LANES));
+			acc2 = ApplySse2<Op>(acc2, LoadSse2(a + i + 2 * LANES));
+			acc3 = ApplySse2<Op>(acc3, LoadSse2(a + i + 3 * LANES));
+		}
+		const auto acc = ApplySse2<Op>(ApplySse2<Op>(acc0, acc1), ApplySse2<Op>(acc2, acc3));
+		return ReduceScalar<Op>(a, i, n, Op::Apply(init, HorizontalSse2<Op, T>(acc)));
+	}
+
+	template<typename T>
+	__attribute__((target("sse2"))) T DotSse2(const T* a, const T* b, size_t n)
+	{
+		using Plus = OPERATIONS::Plus;
+		using Multiplies = OPERATIONS::Multiplies;
+		constexpr size_t LANES = 16 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return DotScalar(a, b, 0, n, T(0));
+		auto acc0 = ApplySse2<Multiplies>(LoadSse2(a), LoadSse2(b));
+		auto acc1 = ApplySse2<Multiplies>(LoadSse2(a + LANES), LoadSse2(b + LANES));
+		auto acc2 = ApplySse2<Multiplies>(LoadSse2(a + 2 * LANES), LoadSse2(b + 2 * LANES));
+		auto acc3 = ApplySse2<Multiplies>(LoadSse2(a + 3 * LANES), LoadSse2(b + 3 * LANES));
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplySse2<Plus>(acc0, ApplySse2<Multiplies>(LoadSse2(a + i), LoadSse2(b + i)));
+			acc1 = ApplySse2<Plus>(acc1, ApplySse2<Multiplies>(LoadSse2(a + i + LANES), LoadSse2(b + i + LANES)));
+			acc2 = ApplySse2<Plus>(acc2, ApplySse2<Multiplies>(LoadSse2(a + i + 2 * LANES), LoadSse2(b + i + 2 * LANES)));
+			acc3 = ApplySse2<Plus>(acc3, ApplySse2<Multiplies>(LoadSse2(a + i + 3 * LANES), LoadSse2(b + i + 3 * LANES)));
+		}
+		const auto acc = ApplySse2<Plus>(ApplySse2<Plus>(acc0, acc1), ApplySse2<Plus>(acc2, acc3));
+		return DotScalar(a, b, i, n, HorizontalSse2<Plus, T>(acc));
+	}
+
+	template<typename T>
+	__attribute__((target("sse2"))) std::pair<T, T> MinMaxSse2(const T* a, size_t n)
+	{
+		using Min = OPERATIONS::Min;
+		using Max = OPERATIONS::Max;
+		constexpr size_t LANES = 16 / sizeof(T);
+		if (n < 2 * LANES) return MinMaxScalar(a, 1, n, { a[0], a[0] });
+		auto min0 = LoadSse2(a);
+		auto min1 = LoadSse2(a + LANES);
+		auto max0 = min0;
+		auto max1 = min1;
+		size_t i = 2 * LANES;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = LoadSse2(a + i);
+			const auto x1 = LoadSse2(a + i + LANES);
+			min0 = ApplySse2<Min>(min0, x0);
+			min1 = ApplySse2<Min>(min1, x1);
+			max0 = ApplySse2<Max>(max0, x0);
+			max1 = ApplySse2<Max>(max1, x1);
+		}
+		return MinMaxScalar(a, i, n, {
+				HorizontalSse2<Min, T>(ApplySse2<Min>(min0, min1)),
+				HorizontalSse2<Max, T>(ApplySse2<Max>(max0, max1)) });
+	}
+
+	//======//
+	// AVX2 //
+	//======//
+
+	template<typename Op, typename T, typename V>
+	__attribute__((target("avx2"))) inline T HorizontalAvx2(V x)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		T lanes[LANES];
+		StoreAvx2(lanes, x);
+		return ReduceScalar<Op>(lanes, 1, LANES, lanes[0]);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx2"))) T ReduceAvx2(const T* a, size_t n, T init)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return ReduceScalar<Op>(a, 0, n, init);
+		auto acc0 = LoadAvx2(a);
+		auto acc1 = LoadAvx2(a + LANES);
+		auto acc2 = LoadAvx2(a + 2 * LANES);
+		auto acc3 = LoadAvx2(a + 3 * LANES);
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplyAvx2<Op>(acc0, LoadAvx2(a + i));
+			acc1 = ApplyAvx2<Op>(acc1, LoadAvx2(a + i + LANES));
+			acc2 = ApplyAvx2<Op>(acc2, LoadAvx2(a + i + 2 * LANES));
+			acc3 = ApplyAvx2<Op>(acc3, LoadAvx2(a + i + 3 * LANES));
+		}
+		const auto acc = ApplyAvx2<Op>(ApplyAvx2<Op>(acc0, acc1), ApplyAvx2<Op>(acc2, acc3));
+		return ReduceScalar<Op>(a, i, n, Op::Apply(init, HorizontalAvx2<Op, T>(acc)));
+	}
+
+	template<typename T>
+	__attribute__((target("avx2"))) T DotAvx2(const T* a, const T* b, size_t n)
+	{
+		using Plus = OPERATIONS::Plus;
+		using Multiplies = OPERATIONS::Multiplies;
+		constexpr size_t LANES = 32 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return DotScalar(a, b, 0, n, T(0));
+		auto acc0 = ApplyAvx2<Multiplies>(LoadAvx2(a), LoadAvx2(b));
+		auto acc1 = ApplyAvx2<Multiplies>(LoadAvx2(a + LANES), LoadAvx2(b + LANES));
+		auto acc2 = ApplyAvx2<Multiplies>(LoadAvx2(a + 2 * LANES), LoadAvx2(b + 2 * LANES));
+		auto acc3 = ApplyAvx2<Multiplies>(LoadAvx2(a + 3 * LANES), LoadAvx2(b + 3 * LANES));
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplyAvx2<Plus>(acc0, ApplyAvx2<Multiplies>(LoadAvx2(a + i), LoadAvx2(b + i)));
+			acc1 = ApplyAvx2<Plus>(acc1, ApplyAvx2<Multiplies>(LoadAvx2(a + i + LANES), LoadAvx2(b + i + LANES)));
+			acc2 = ApplyAvx2<Plus>(acc2, ApplyAvx2<Multiplies>(LoadAvx2(a + i + 2 * LANES), LoadAvx2(b + i + 2 * LANES)));
+			acc3 = ApplyAvx2<Plus>(acc3, ApplyAvx2<Multiplies>(LoadAvx2(a + i + 3 * LANES), LoadAvx2(b + i + 3 * LANES)));
+		}
+		const auto acc = ApplyAvx2<Plus>(ApplyAvx2<Plus>(acc0, acc1), ApplyAvx2<Plus>(acc2, acc3));
+		return DotScalar(a, b, i, n, HorizontalAvx2<Plus, T>(acc));
+	}
+
+	template<typename T>
+	__attribute__((target("avx2"))) std::pair<T, T> MinMaxAvx2(const T* a, size_t n)
+	{
+		using Min = OPERATIONS::Min;
+		using Max = OPERATIONS::Max;
+		constexpr size_t LANES = 32 / sizeof(T);
+		if (n < 2 * LANES) return MinMaxScalar(a, 1, n, { a[0], a[0] });
+		auto min0 = LoadAvx2(a);
+		auto min1 = LoadAvx2(a + LANES);
+		auto max0 = min0;
+		auto max1 = min1;
+		size_t i = 2 * LANES;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = LoadAvx2(a + i);
+			const auto x1 = LoadAvx2(a + i + LANES);
+			min0 = ApplyAvx2<Min>(min0, x0);
+			min1 = ApplyAvx2<Min>(min1, x1);
+			max0 = ApplyAvx2<Max>(max0, x0);
+			max1 = ApplyAvx2<Max>(max1, x1);
+		}
+		return MinMaxScalar(a, i, n, {
+				HorizontalAvx2<Min, T>(ApplyAvx2<Min>(min0, min1)),
+				HorizontalAvx2<Max, T>(ApplyAvx2<Max>(max0, max1)) });
+	}
+
+	//=========//
+	// AVX-512 //
+	//=========//
+
+	template<typename Op, typename T, typename V>
+	__attribute__((target("avx512f"))) inline T HorizontalAvx512(V x)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		T lanes[LANES];
+		StoreAvx512(lanes, x);
+		return ReduceScalar<Op>(lanes, 1, LANES, lanes[0]);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx512f"))) T ReduceAvx512(const T* a, size_t n, T init)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return ReduceScalar<Op>(a, 0, n, init);
+		auto acc0 = LoadAvx512(a);
+		auto acc1 = LoadAvx512(a + LANES);
+		auto acc2 = LoadAvx512(a + 2 * LANES);
+		auto acc3 = LoadAvx512(a + 3 * LANES);
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplyAvx512<Op>(acc0, LoadAvx512(a + i));
+			acc1 = ApplyAvx512<Op>(acc1, LoadAvx512(a + i + LANES));
+			acc2 = ApplyAvx512<Op>(acc2, LoadAvx512(a + i + 2 * LANES));
+			acc3 = ApplyAvx512<Op>(acc3, LoadAvx512(a + i + 3 * LANES));
+		}
+		const auto acc = ApplyAvx512<Op>(ApplyAvx512<Op>(acc0, acc1), ApplyAvx512<Op>(acc2, acc3));
+		return ReduceScalar<Op>(a, i, n, Op::Apply(init, HorizontalAvx512<Op, T>(acc)));
+	}
+
+	template<typename T>
+	__attribute__((target("avx512f"))) T DotAvx512(const T* a, const T* b, size_t n)
+	{
+		using Plus = OPERATIONS::Plus;
+		using Multiplies = OPERATIONS::Multiplies;
+		constexpr size_t LANES = 64 / sizeof(T);
+		if (n < NUM_ACCUMULATORS * LANES) return DotScalar(a, b, 0, n, T(0));
+		auto acc0 = ApplyAvx512<Multiplies>(LoadAvx512(a), LoadAvx512(b));
+		auto acc1 = ApplyAvx512<Multiplies>(LoadAvx512(a + LANES), LoadAvx512(b + LANES));
+		auto acc2 = ApplyAvx512<Multiplies>(LoadAvx512(a + 2 * LANES), LoadAvx512(b + 2 * LANES));
+		auto acc3 = ApplyAvx512<Multiplies>(LoadAvx512(a + 3 * LANES), LoadAvx512(b + 3 * LANES));
+		size_t i = NUM_ACCUMULATORS * LANES;
+		for (; i + NUM_ACCUMULATORS * LANES <= n; i += NUM_ACCUMULATORS * LANES)
+		{
+			acc0 = ApplyAvx512<Plus>(acc0, ApplyAvx512<Multiplies>(LoadAvx512(a + i), LoadAvx512(b + i)));
+			acc1 = ApplyAvx512<Plus>(acc1, ApplyAvx512<Multiplies>(LoadAvx512(a + i + LANES), LoadAvx512(b + i + LANES)));
+			acc2 = ApplyAvx512<Plus>(acc2, ApplyAvx512<Multiplies>(LoadAvx512(a + i + 2 * LANES), LoadAvx512(b + i + 2 * LANES)));
+			acc3 = ApplyAvx512<Plus>(acc3, ApplyAvx512<Multiplies>(LoadAvx512(a + i + 3 * LANES), LoadAvx512(b + i + 3 * LANES)));
+		}
+		const auto acc = ApplyAvx512<Plus>(ApplyAvx512<Plus>(acc0, acc1), ApplyAvx512<Plus>(acc2, acc3));
+		return DotScalar(a, b, i, n, HorizontalAvx512<Plus, T>(acc));
+	}
+
+	template<typename T>
+	__attribute__((target("avx512f"))) std::pair<T, T> MinMaxAvx512(const T* a, size_t n)
+	{
+		using Min = OPERATIONS::Min;
+		using Max = OPERATIONS::Max;
+		constexpr size_t LANES = 64 / sizeof(T);
+		if (n < 2 * LANES) return MinMaxScalar(a, 1, n, { a[0], a[0] });
+		auto min0 = LoadAvx512(a);
+		auto min1 = LoadAvx512(a + LANES);
+		auto max0 = min0;
+		auto max1 = min1;
+		size_t i = 2 * LANES;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = LoadAvx512(a + i);
+			const auto x1 = LoadAvx512(a + i + LANES);
+			min0 = ApplyAvx512<Min>(min0, x0);
+			min1 = ApplyAvx512<Min>(min1, x1);
+			max0 = ApplyAvx512<Max>(max0, x0);
+			max1 = ApplyAvx512<Max>(max1, x1);
+		}
+		return MinMaxScalar(a, i, n, {
+				HorizontalAvx512<Min, T>(ApplyAvx512<Min>(min0, min1)),
+				HorizontalAvx512<Max, T>(ApplyAvx512<Max>(max0, max1)) });
+	}
+
+#endif
+
+	//===================================================================//
+	// Dispatchers: Reduce<Op> folds a[0..n) into init with Op (Plus,    //
+	// Min, Max), Dot is the sum of a[i] * b[i] and MinMax returns the   //
+	// smallest and the largest element of a non-empty array. With NaNs  //
+	// in the input the result of Min, Max and MinMax is unspecified.    //
+	// Policies that are not VECTORIZED run the portable scalar kernels. //
+	// These run on the calling thread: see the whole-array reductions   //
+	// below for the threaded versions.                                  //
+	//===================================================================//
+
+	template<typename Op, typename Policy, typename T>
+	T Reduce(Policy, const T* a, size_t n, T init, size_t stride = 1)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if (stride != 1) return ReduceStrided<Op>(a, n, stride, init);
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return ReduceAvx512<Op>(a, n, init);
+				case UTILITIES::SimdLevel::AVX2:
+					return ReduceAvx2<Op>(a, n, init);
+				case UTILITIES::SimdLevel::SSE2:
+					return ReduceSse2<Op>(a, n, init);
+				default:
+					break;
+			}
+		}
+#endif
+		return ReduceScalar<Op>(a, 0, n, init);
+	}
+
+	template<typename Policy, typename T>
+	T Dot(Policy, const T* a, const T* b, size_t n, size_t strideA = 1, size_t strideB = 1)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if (strideA != 1 || strideB != 1) return DotStrided(a, strideA, b, strideB, n);
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return DotAvx512(a, b, n);
+				case UTILITIES::SimdLevel::AVX2:
+					return DotAvx2(a, b, n);
+				case UTILITIES::SimdLevel::SSE2:
+					return DotSse2(a, b, n);
+				default:
+					break;
+			}
+		}
+#endif
+		return DotScalar(a, b, 0, n, T(0));
+	}
+
+	template<typename Policy, typename T>
+	std::pair<T, T> MinMax(Policy, const T* a, size_t n, size_t stride = 1)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+		if (stride != 1) return MinMaxStrided(a, n, stride);
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return MinMaxAvx512(a, n);
+				case UTILITIES::SimdLevel::AVX2:
+					return MinMaxAvx2(a, n);
+				case UTILITIES::SimdLevel::SSE2:
+					return MinMaxSse2(a, n);
+				default:
+					break;
+			}
+		}
+#endif
+		return MinMaxScalar(a, 1, n, { a[0], a[0] });
+	}
+
+	//========================//
+	// Compensated summations //
+	//========================//
+
+	// Neumaier's variant of Kahan summation: also exact when an element is larger than the running sum
+	template<typename T>
+	T SumKahan(const T* a, size_t n, size_t stride = 1)
+	{
+		T sum = T(0);
+		T compensation = T(0);
+		for (size_t i = 0; i < n; i++)
+		{
+			const T x = a[i * stride];
+			const T t = sum + x;
+			if ((sum < 0 ? -sum : sum) >= (x < 0 ? -x : x))
+			{
+				compensation += (sum - t) + x;
+			}
+			else
+			{
+				compensation += (x - t) + sum;
+			}
+			sum = t;
+		}
+		return sum + compensation;
+	}
+
+	template<typename Policy, typename T>
+	T SumPairwise(Policy policy, const T* a, size_t n, size_t stride = 1)
+	{
+		if (n <= PAIRWISE_BLOCK_SIZE) return Reduce<OPERATIONS::Plus>(policy, a, n, T(0), stride);
+		// split on a block boundary, so that the blocks are the same at every level
+		const size_t half = (n / 2 + PAIRWISE_BLOCK_SIZE - 1) / PAIRWISE_BLOCK_SIZE * PAIRWISE_BLOCK_SIZE;
+		return SumPairwise(policy, a, half, stride) + SumPairwise(policy, a + half * stride, n - half, stride);
+	}
+
+	template<typename Policy, typename T>
+	T Sum(Policy policy, const T* a, size_t n, Summation summation, size_t stride = 1)
+	{
+		switch (summation)
+		{
+			case Summation::KAHAN:
+				return SumKahan(a, n, stride);
+			case Summation::PAIRWISE:
+				return SumPairwise(policy, a, n, stride);
+			default:
+				return Reduce<OPERATIONS::Plus>(policy, a, n, T(0), stride);
+		}
+	}
+
+	//===================================================================//
+	// Whole-array reductions shared by the containers and views, with   //
+	// element i at a[i * stride]. Under parallel policies, large arrays //
+	// are reduced chunk by chunk on the worker threads over the static  //
+	// partition, and the per-chunk results are combined in chunk order: //
+	// the result only depends on the number of threads. Min, Max,       //
+	// MinMax and the Arg versions need n > 0.                           //
+	//===================================================================//
+
+	template<typename Policy, typename T>
+	T SumAll(Policy policy, const T* a, size_t n, Summation summation, size_t stride = 1)
+	{
+		if (!IsParallel<T>(policy, n)) return Sum(policy, a, n, summation, stride);
+		const auto partials = ParallelPartials<T>(n, [policy, a, summation, stride](size_t begin, size_t end)
+		{
+			return Sum(policy, a + begin * stride, end - begin, summation, stride);
+		});
+		return Sum(policy, partials.data(), partials.size(), summation);
+	}
+
+	template<typename Policy, typename T>
+	T DotAll(Policy policy, const T* a, const T* b, size_t n, size_t strideA = 1, size_t strideB = 1)
+	{
+		if (!IsParallel<T>(policy, n)) return Dot(policy, a, b, n, strideA, strideB);
+		const auto partials = ParallelPartials<T>(n, [policy, a, b, strideA, strideB](size_t begin, size_t end)
+		{
+			return Dot(policy, a + begin * strideA, b + begin * strideB, end - begin, strideA, strideB);
+		});
+		return Reduce<OPERATIONS::Plus>(policy, partials.data(), partials.size(), T(0));
+	}
+
+	template<typename Op, typename Policy, typename T>
+	T ReduceAll(Policy policy, const T* a, size_t n, size_t stride = 1)
+	{
+		if (!IsParallel<T>(policy, n)) return Reduce<Op>(policy, a + stride, n - 1, a[0], stride);
+		const auto partials = ParallelPartials<T>(n, [policy, a, stride](size_t begin, size_t end)
+		{
+			return Reduce<Op>(policy, a + (begin + 1) * stride, end - begin - 1, a[begin * stride], stride);
+		});
+		return Reduce<Op>(policy, partials.data() + 1, partials.size() - 1, partials[0]);
+	}
+
+	template<typename Policy, typename T>
+	std::pair<T, T> MinMaxAll(Policy policy, const T* a, size_t n, size_t stride = 1)
+	{
+		if (!IsParallel<T>(policy, n)) return MinMax(policy, a, n, stride);
+		const auto partials = ParallelPartials<T>(n, [policy, a, stride](size_t begin, size_t end)
+		{
+			return MinMax(policy, a + begin * stride, end - begin, stride);
+		});
+		auto res = partials[0];
+		for (size_t k = 1; k < partials.size(); k++)
+		{
+			res.first = OPERATIONS::Min::Apply(res.first, partials[k].first);
+			res.second = OPERATIONS::Max::Apply(res.second, partials[k].second);
+		}
+		return res;
+	}
+
+	// index of the first element equal to the Op-extreme: found with the kernels, then its position with a scan
+	template<typename Op, typename Policy, typename T>
+	size_t ArgReduceAll(Policy policy, const T* a, size_t n, size_t stride = 1)
+	{
+		const auto chunkArg = [policy, a, stride](size_t begin, size_t end)
+		{
+			const T val = Reduce<Op>(policy, a + (begin + 1) * stride, end - begin - 1, a[begin * stride], stride);
+			size_t idx = begin;
+			while (idx < end && a[idx * stride] != val) idx++;
+			return std::make_pair(val, idx);
+		};
+		if (!IsParallel<T>(policy, n)) return chunkArg(0, n).second;
+
+		const auto partials = ParallelPartials<T>(n, chunkArg);
+		auto res = partials[0];
+		for (size_t k = 1; k < partials.size(); k++)
+		{
+			// ties keep the earlier chunk
+			if (Op::Apply(res.first, partials[k].first) != res.first) res = partials[k];
+		}
+		return res.second;
+	}
+}
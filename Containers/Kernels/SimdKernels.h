@@ -0,0 +1,452 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include "../Expressions/Operations.h"
+#include "../Execution/ExecutionPolicy.h"
+#include "../../Utilities/CpuFeatures.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEPOLIA4_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//=================================================================//
+	// Explicit SSE2 / AVX2 / AVX-512 kernels for the elementwise      //
+	// operations on contiguous float and double arrays.               //
+	// Every instruction set is compiled into the binary through       //
+	// function target attributes and the widest one supported by      //
+	// the running CPU is picked at run time (UTILITIES::CpuFeatures). //
+	//=================================================================//
+
+	template<typename T>
+	constexpr bool IS_SIMD_TYPE = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+	template<typename Op>
+	constexpr bool IS_SIMD_OPERATION =
+			std::is_same_v<Op, OPERATIONS::Plus> ||
+			std::is_same_v<Op, OPERATIONS::Minus> ||
+			std::is_same_v<Op, OPERATIONS::Multiplies> ||
+			std::is_same_v<Op, OPERATIONS::Divides>;
+
+	//=========================//
+	// Portable scalar kernels //
+	//=========================//
+
+	template<typename Op, typename T>
+	void BinaryScalar(const T* a, const T* b, T* c, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			c[i] = Op::Apply(a[i], b[i]);
+		}
+	}
+
+	template<typename Op, typename T>
+	void BinaryScalar(const T* a, T val, T* c, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			c[i] = Op::Apply(a[i], val);
+		}
+	}
+
+	template<typename Op, typename T>
+	void BinaryScalar(T val, const T* b, T* c, size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			c[i] = Op::Apply(val, b[i]);
+		}
+	}
+
+#ifdef SEPOLIA4_X86_SIMD
+
+	//======//
+	// SSE2 //
+	//======//
+
+	__attribute__((target("sse2"))) inline __m128d LoadSse2(const double* p)
+	{
+		return _mm_loadu_pd(p);
+	}
+
+	__attribute__((target("sse2"))) inline __m128 LoadSse2(const float* p)
+	{
+		return _mm_loadu_ps(p);
+	}
+
+	__attribute__((target("sse2"))) inline void StoreSse2(double* p, __m128d x)
+	{
+		_mm_storeu_pd(p, x);
+	}
+
+	__attribute__((target("sse2"))) inline void StoreSse2(float* p, __m128 x)
+	{
+		_mm_storeu_ps(p, x);
+	}
+
+	__attribute__((target("sse2"))) inline __m128d BroadcastSse2(double val)
+	{
+		return _mm_set1_pd(val);
+	}
+
+	__attribute__((target("sse2"))) inline __m128 BroadcastSse2(float val)
+	{
+		return _mm_set1_ps(val);
+	}
+
+	template<typename Op>
+	__attribute__((target("sse2"))) inline __m128d ApplySse2(__m128d a, __m128d b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm_add_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm_sub_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm_mul_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm_min_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm_max_pd(a, b);
+		else return _mm_div_pd(a, b);
+	}
+
+	template<typename Op>
+	__attribute__((target("sse2"))) inline __m128 ApplySse2(__m128 a, __m128 b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm_add_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm_sub_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm_mul_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm_min_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm_max_ps(a, b);
+		else return _mm_div_ps(a, b);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("sse2"))) void BinarySse2(const T* a, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplySse2<Op>(LoadSse2(a + i), LoadSse2(b + i));
+			const auto x1 = ApplySse2<Op>(LoadSse2(a + i + LANES), LoadSse2(b + i + LANES));
+			StoreSse2(c + i, x0);
+			StoreSse2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, b, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("sse2"))) void BinarySse2(const T* a, T val, T* c, size_t n)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		const auto v = BroadcastSse2(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplySse2<Op>(LoadSse2(a + i), v);
+			const auto x1 = ApplySse2<Op>(LoadSse2(a + i + LANES), v);
+			StoreSse2(c + i, x0);
+			StoreSse2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, val, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("sse2"))) void BinarySse2(T val, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 16 / sizeof(T);
+		const auto v = BroadcastSse2(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplySse2<Op>(v, LoadSse2(b + i));
+			const auto x1 = ApplySse2<Op>(v, LoadSse2(b + i + LANES));
+			StoreSse2(c + i, x0);
+			StoreSse2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(val, b, c, i, n);
+	}
+
+	//======//
+	// AVX2 //
+	//======//
+
+	__attribute__((target("avx2"))) inline __m256d LoadAvx2(const double* p)
+	{
+		return _mm256_loadu_pd(p);
+	}
+
+	__attribute__((target("avx2"))) inline __m256 LoadAvx2(const float* p)
+	{
+		return _mm256_loadu_ps(p);
+	}
+
+	__attribute__((target("avx2"))) inline void StoreAvx2(double* p, __m256d x)
+	{
+		_mm256_storeu_pd(p, x);
+	}
+
+	__attribute__((target("avx2"))) inline void StoreAvx2(float* p, __m256 x)
+	{
+		_mm256_storeu_ps(p, x);
+	}
+
+	__attribute__((target("avx2"))) inline __m256d BroadcastAvx2(double val)
+	{
+		return _mm256_set1_pd(val);
+	}
+
+	__attribute__((target("avx2"))) inline __m256 BroadcastAvx2(float val)
+	{
+		return _mm256_set1_ps(val);
+	}
+
+	template<typename Op>
+	__attribute__((target("avx2"))) inline __m256d ApplyAvx2(__m256d a, __m256d b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm256_add_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm256_sub_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm256_mul_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm256_min_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm256_max_pd(a, b);
+		else return _mm256_div_pd(a, b);
+	}
+
+	template<typename Op>
+	__attribute__((target("avx2"))) inline __m256 ApplyAvx2(__m256 a, __m256 b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm256_add_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm256_sub_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm256_mul_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm256_min_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm256_max_ps(a, b);
+		else return _mm256_div_ps(a, b);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx2"))) void BinaryAvx2(const T* a, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx2<Op>(LoadAvx2(a + i), LoadAvx2(b + i));
+			const auto x1 = ApplyAvx2<Op>(LoadAvx2(a + i + LANES), LoadAvx2(b + i + LANES));
+			StoreAvx2(c + i, x0);
+			StoreAvx2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, b, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx2"))) void BinaryAvx2(const T* a, T val, T* c, size_t n)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		const auto v = BroadcastAvx2(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx2<Op>(LoadAvx2(a + i), v);
+			const auto x1 = ApplyAvx2<Op>(LoadAvx2(a + i + LANES), v);
+			StoreAvx2(c + i, x0);
+			StoreAvx2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, val, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx2"))) void BinaryAvx2(T val, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 32 / sizeof(T);
+		const auto v = BroadcastAvx2(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx2<Op>(v, LoadAvx2(b + i));
+			const auto x1 = ApplyAvx2<Op>(v, LoadAvx2(b + i + LANES));
+			StoreAvx2(c + i, x0);
+			StoreAvx2(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(val, b, c, i, n);
+	}
+
+	//=========//
+	// AVX-512 //
+	//=========//
+
+	__attribute__((target("avx512f"))) inline __m512d LoadAvx512(const double* p)
+	{
+		return _mm512_loadu_pd(p);
+	}
+
+	__attribute__((target("avx512f"))) inline __m512 LoadAvx512(const float* p)
+	{
+		return _mm512_loadu_ps(p);
+	}
+
+	__attribute__((target("avx512f"))) inline void StoreAvx512(double* p, __m512d x)
+	{
+		_mm512_storeu_pd(p, x);
+	}
+
+	__attribute__((target("avx512f"))) inline void StoreAvx512(float* p, __m512 x)
+	{
+		_mm512_storeu_ps(p, x);
+	}
+
+	__attribute__((target("avx512f"))) inline __m512d BroadcastAvx512(double val)
+	{
+		return _mm512_set1_pd(val);
+	}
+
+	__attribute__((target("avx512f"))) inline __m512 BroadcastAvx512(float val)
+	{
+		return _mm512_set1_ps(val);
+	}
+
+	template<typename Op>
+	__attribute__((target("avx512f"))) inline __m512d ApplyAvx512(__m512d a, __m512d b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm512_add_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm512_sub_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm512_mul_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm512_min_pd(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm512_max_pd(a, b);
+		else return _mm512_div_pd(a, b);
+	}
+
+	template<typename Op>
+	__attribute__((target("avx512f"))) inline __m512 ApplyAvx512(__m512 a, __m512 b)
+	{
+		if constexpr (std::is_same_v<Op, OPERATIONS::Plus>) return _mm512_add_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Minus>) return _mm512_sub_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>) return _mm512_mul_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Min>) return _mm512_min_ps(a, b);
+		else if constexpr (std::is_same_v<Op, OPERATIONS::Max>) return _mm512_max_ps(a, b);
+		else return _mm512_div_ps(a, b);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx512f"))) void BinaryAvx512(const T* a, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx512<Op>(LoadAvx512(a + i), LoadAvx512(b + i));
+			const auto x1 = ApplyAvx512<Op>(LoadAvx512(a + i + LANES), LoadAvx512(b + i + LANES));
+			StoreAvx512(c + i, x0);
+			StoreAvx512(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, b, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx512f"))) void BinaryAvx512(const T* a, T val, T* c, size_t n)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		const auto v = BroadcastAvx512(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx512<Op>(LoadAvx512(a + i), v);
+			const auto x1 = ApplyAvx512<Op>(LoadAvx512(a + i + LANES), v);
+			StoreAvx512(c + i, x0);
+			StoreAvx512(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(a, val, c, i, n);
+	}
+
+	template<typename Op, typename T>
+	__attribute__((target("avx512f"))) void BinaryAvx512(T val, const T* b, T* c, size_t n)
+	{
+		constexpr size_t LANES = 64 / sizeof(T);
+		const auto v = BroadcastAvx512(val);
+		size_t i = 0;
+		for (; i + 2 * LANES <= n; i += 2 * LANES)
+		{
+			const auto x0 = ApplyAvx512<Op>(v, LoadAvx512(b + i));
+			const auto x1 = ApplyAvx512<Op>(v, LoadAvx512(b + i + LANES));
+			StoreAvx512(c + i, x0);
+			StoreAvx512(c + i + LANES, x1);
+		}
+		BinaryScalar<Op>(val, b, c, i, n);
+	}
+
+#endif
+
+	//===================================================================//
+	// Dispatchers: c[i] = a[i] op b[i], c[i] = a[i] op val and          //
+	// c[i] = val op b[i]. The output may alias an input (same index).   //
+	// Policies that are not VECTORIZED run the portable scalar kernels. //
+	//===================================================================//
+
+	template<typename Op, typename Policy, typename T>
+	void Binary(Policy, const T* a, const T* b, T* c, size_t n)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T> && IS_SIMD_OPERATION<Op>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return BinaryAvx512<Op>(a, b, c, n);
+				case UTILITIES::SimdLevel::AVX2:
+					return BinaryAvx2<Op>(a, b, c, n);
+				case UTILITIES::SimdLevel::SSE2:
+					return BinarySse2<Op>(a, b, c, n);
+				default:
+					break;
+			}
+		}
+#endif
+		BinaryScalar<Op>(a, b, c, 0, n);
+	}
+
+	template<typename Op, typename Policy, typename T>
+	void Binary(Policy, const T* a, T val, T* c, size_t n)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T> && IS_SIMD_OPERATION<Op>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return BinaryAvx512<Op>(a, val, c, n);
+				case UTILITIES::SimdLevel::AVX2:
+					return BinaryAvx2<Op>(a, val, c, n);
+				case UTILITIES::SimdLevel::SSE2:
+					return BinarySse2<Op>(a, val, c, n);
+				default:
+					break;
+			}
+		}
+#endif
+		BinaryScalar<Op>(a, val, c, 0, n);
+	}
+
+	template<typename Op, typename Policy, typename T>
+	void Binary(Policy, T val, const T* b, T* c, size_t n)
+	{
+		static_assert(EXECUTION::IS_EXECUTION_POLICY<Policy>, "Policy must be an execution policy");
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T> && IS_SIMD_OPERATION<Op>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return BinaryAvx512<Op>(val, b, c, n);
+				case UTILITIES::SimdLevel::AVX2:
+					return BinaryAvx2<Op>(val, b, c, n);
+				case UTILITIES::SimdLevel::SSE2:
+					return BinarySse2<Op>(val, b, c, n);
+				default:
+					break;
+			}
+		}
+#endif
+		BinaryScalar<Op>(val, b, c, 0, n);
+	}
+}
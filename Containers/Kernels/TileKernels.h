@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "ParallelKernels.h"
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//=================================================================//
+	// Conversions between row-major arrays with leading dimensions    //
+	// and tile-contiguous storage: TILE x TILE row-major tiles stored //
+	// back to back, the tiles of a tile row next to each other and    //
+	// the tile rows one after the other. The tiles on the bottom and  //
+	// right edges keep the full TILE x TILE size; the elements past   //
+	// the array are left untouched. Each tile row is a separate task, //
+	// copied in runs of up to TILE elements, contiguous on both sides //
+	//=================================================================//
+
+	template<size_t TILE>
+	constexpr size_t TileCount(size_t n)
+	{
+		return (n + TILE - 1) / TILE;
+	}
+
+	// tiles = A(0:rows, 0:cols) in tiles
+	template<size_t TILE, typename Policy, typename T>
+	void PackTiles(Policy policy, size_t rows, size_t cols, const T* a, size_t lda, T* tiles)
+	{
+		const size_t tileCols = TileCount<TILE>(cols);
+		ForRows<T>(policy, TileCount<TILE>(rows), TILE * cols, [=](size_t beginTileRow, size_t endTileRow)
+		{
+			for (size_t ti = beginTileRow; ti < endTileRow; ti++)
+			{
+				const size_t tileRows = std::min(TILE, rows - ti * TILE);
+				for (size_t tj = 0; tj < tileCols; tj++)
+				{
+					const size_t tileWidth = std::min(TILE, cols - tj * TILE);
+					const T* const src = a + ti * TILE * lda + tj * TILE;
+					T* const dst = tiles + (ti * tileCols + tj) * TILE * TILE;
+					for (size_t i = 0; i < tileRows; i++)
+					{
+						std::copy_n(src + i * lda, tileWidth, dst + i * TILE);
+					}
+				}
+			}
+		});
+	}
+
+	// B(0:rows, 0:cols) = the array in tiles
+	template<size_t TILE, typename Policy, typename T>
+	void UnpackTiles(Policy policy, size_t rows, size_t cols, const T* tiles, T* b, size_t ldb)
+	{
+		const size_t tileCols = TileCount<TILE>(cols);
+		ForRows<T>(policy, TileCount<TILE>(rows), TILE * cols, [=](size_t beginTileRow, size_t endTileRow)
+		{
+			for (size_t ti = beginTileRow; ti < endTileRow; ti++)
+			{
+				const size_t tileRows = std::min(TILE, rows - ti * TILE);
+				for (size_t tj = 0; tj < tileCols; tj++)
+				{
+					const size_t tileWidth = std::min(TILE, cols - tj * TILE);
+					const T* const src = tiles + (ti * tileCols + tj) * TILE * TILE;
+					T* const dst = b + ti * TILE * ldb + tj * TILE;
+					for (size_t i = 0; i < tileRows; i++)
+					{
+						std::copy_n(src + i * TILE, tileWidth, dst + i * ldb);
+					}
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SimdKernels.h"
+#include "ParallelKernels.h"
+#include "../../Utilities/CpuFeatures.h"
+
+namespace SEPOLIA4::CONTAINERS::KERNELS
+{
+	//================================================================//
+	// Transposes of row-major arrays with leading dimensions.        //
+	// B = A^T recurses on the longer side of A until both sides fit  //
+	// a leaf (cache-oblivious: every cache level sees blocks that    //
+	// fit it), and the leaves go through K x K tiles transposed in   //
+	// SIMD registers, so each tile is read and written in whole      //
+	// vectors. In-place transposes swap tile pairs across the        //
+	// diagonal for square matrices and follow the permutation cycles //
+	// for rectangular ones, with one bit of bookkeeping per element. //
+	//================================================================//
+
+	// the recursion stops at leaves of at most this many rows and columns
+	template<typename T>
+	constexpr size_t TRANSPOSE_LEAF = 256 / sizeof(T) > 16 ? 256 / sizeof(T) : 16;
+
+	// B(0:cols, 0:rows) = A(0:rows, 0:cols)^T, element by element
+	template<typename T>
+	void TransposeScalar(size_t rows, size_t cols, const T* a, size_t lda, T* b, size_t ldb)
+	{
+		for (size_t i = 0; i < rows; i++)
+		{
+			for (size_t j = 0; j < cols; j++)
+			{
+				b[j * ldb + i] = a[i * lda + j];
+			}
+		}
+	}
+
+	template<typename T>
+	struct TransposeKernelScalar
+	{
+		static constexpr size_t K = 1;
+
+		static void Run(const T* a, size_t, T* b, size_t)
+		{
+			*b = *a;
+		}
+	};
+
+#ifdef SEPOLIA4_X86_SIMD
+
+	//======//
+	// SSE2 //
+	//======//
+
+	__attribute__((target("sse2"))) inline void Transpose2x2Sse2(const double* a, size_t lda, double* b, size_t ldb)
+	{
+		const __m128d r0 = _mm_loadu_pd(a);
+		const __m128d r1 = _mm_loadu_pd(a + lda);
+		_mm_storeu_pd(b, _mm_unpacklo_pd(r0, r1));
+		_mm_storeu_pd(b + ldb, _mm_unpackhi_pd(r0, r1));
+	}
+
+	__attribute__((target("sse2"))) inline void Transpose4x4Sse2(const float* a, size_t lda, float* b, size_t ldb)
+	{
+		__m128 r0 = _mm_loadu_ps(a);
+		__m128 r1 = _mm_loadu_ps(a + lda);
+		__m128 r2 = _mm_loadu_ps(a + 2 * lda);
+		__m128 r3 = _mm_loadu_ps(a + 3 * lda);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(b, r0);
+		_mm_storeu_ps(b + ldb, r1);
+		_mm_storeu_ps(b + 2 * ldb, r2);
+		_mm_storeu_ps(b + 3 * ldb, r3);
+	}
+
+	//======//
+	// AVX2 //
+	//======//
+
+	__attribute__((target("avx2"))) inline void Transpose4x4Avx2(const double* a, size_t lda, double* b, size_t ldb)
+	{
+		const __m256d r0 = _mm256_loadu_pd(a);
+		const __m256d r1 = _mm256_loadu_pd(a + lda);
+		const __m256d r2 = _mm256_loadu_pd(a + 2 * lda);
+		const __m256d r3 = _mm256_loadu_pd(a + 3 * lda);
+		const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+		const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+		const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+		const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+		_mm256_storeu_pd(b, _mm256_permute2f128_pd(t0, t2, 0x20));
+		_mm256_storeu_pd(b + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+		_mm256_storeu_pd(b + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+		_mm256_storeu_pd(b + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+	}
+
+	__attribute__((target("avx2"))) inline void Transpose8x8Avx2(const float* a, size_t lda, float* b, size_t ldb)
+	{
+		__m256 r[8];
+		for (size_t i = 0; i < 8; i++)
+		{
+			r[i] = _mm256_loadu_ps(a + i * lda);
+		}
+		__m256 t[8];
+		for (size_t i = 0; i < 8; i += 2)
+		{
+			t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+			t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+		}
+		__m256 u[8];
+		for (size_t i = 0; i < 8; i += 4)
+		{
+			u[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+			u[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+			u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+			u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		for (size_t i = 0; i < 4; i++)
+		{
+			_mm256_storeu_ps(b + i * ldb, _mm256_permute2f128_ps(u[i], u[i + 4], 0x20));
+			_mm256_storeu_ps(b + (i + 4) * ldb, _mm256_permute2f128_ps(u[i], u[i + 4], 0x31));
+		}
+	}
+
+	//=========//
+	// AVX-512 //
+	//=========//
+
+	__attribute__((target("avx512f"))) inline void Transpose8x8Avx512(const double* a, size_t lda, double* b, size_t ldb)
+	{
+		__m512d r[8];
+		for (size_t i = 0; i < 8; i++)
+		{
+			r[i] = _mm512_loadu_pd(a + i * lda);
+		}
+		// pairs of rows interleaved, then pairs of 128-bit lanes of those, then of the results
+		__m512d t[8];
+		for (size_t i = 0; i < 8; i += 2)
+		{
+			t[i] = _mm512_unpacklo_pd(r[i], r[i + 1]);
+			t[i + 1] = _mm512_unpackhi_pd(r[i], r[i + 1]);
+		}
+		__m512d u[8];
+		for (size_t i = 0; i < 8; i += 4)
+		{
+			u[i] = _mm512_shuffle_f64x2(t[i], t[i + 2], 0x88);
+			u[i + 1] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0x88);
+			u[i + 2] = _mm512_shuffle_f64x2(t[i], t[i + 2], 0xdd);
+			u[i + 3] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0xdd);
+		}
+		for (size_t i = 0; i < 4; i++)
+		{
+			_mm512_storeu_pd(b + i * ldb, _mm512_shuffle_f64x2(u[i], u[i + 4], 0x88));
+			_mm512_storeu_pd(b + (i + 4) * ldb, _mm512_shuffle_f64x2(u[i], u[i + 4], 0xdd));
+		}
+	}
+
+	// K x K tiles per instruction set: one vector per row of the tile
+	template<typename T>
+	struct TransposeKernelSse2
+	{
+		static constexpr size_t K = 16 / sizeof(T);
+
+		static void Run(const T* a, size_t lda, T* b, size_t ldb)
+		{
+			if constexpr (std::is_same_v<T, double>) Transpose2x2Sse2(a, lda, b, ldb);
+			else Transpose4x4Sse2(a, lda, b, ldb);
+		}
+	};
+
+	template<typename T>
+	struct TransposeKernelAvx2
+	{
+		static constexpr size_t K = 32 / sizeof(T);
+
+		static void Run(const T* a, size_t lda, T* b, size_t ldb)
+		{
+			if constexpr (std::is_same_v<T, double>) Transpose4x4Avx2(a, lda, b, ldb);
+			else Transpose8x8Avx2(a, lda, b, ldb);
+		}
+	};
+
+	// 8 x 8 for both: the float tiles are the AVX2 ones (every AVX-512 CPU also has AVX2)
+	template<typename T>
+	struct TransposeKernelAvx512
+	{
+		static constexpr size_t K = 8;
+
+		static void Run(const T* a, size_t lda, T* b, size_t ldb)
+		{
+			if constexpr (std::is_same_v<T, double>) Transpose8x8Avx512(a, lda, b, ldb);
+			else Transpose8x8Avx2(a, lda, b, ldb);
+		}
+	};
+
+#endif
+
+	//===============================//
+	// Out-of-place, cache-oblivious //
+	//===============================//
+
+	template<typename Kernel, typename T>
+	void TransposeLeaf(size_t rows, size_t cols, const T* a, size_t lda, T* b, size_t ldb)
+	{
+		constexpr size_t K = Kernel::K;
+		const size_t rowsK = rows / K * K;
+		const size_t colsK = cols / K * K;
+		for (size_t i = 0; i < rowsK; i += K)
+		{
+			for (size_t j = 0; j < colsK; j += K)
+			{
+				Kernel::Run(a + i * lda + j, lda, b + j * ldb + i, ldb);
+			}
+		}
+		// the right and the bottom edges
+		TransposeScalar(rowsK, cols - colsK, a + colsK, lda, b + colsK * ldb, ldb);
+		TransposeScalar(rows - rowsK, cols, a + rowsK * lda, lda, b + rowsK, ldb);
+	}
+
+	template<typename Kernel, typename T>
+	void TransposeRecursive(size_t rows, size_t cols, const T* a, size_t lda, T* b, size_t ldb)
+	{
+		constexpr size_t LEAF = TRANSPOSE_LEAF<T>;
+		if (rows <= LEAF && cols <= LEAF)
+		{
+			TransposeLeaf<Kernel>(rows, cols, a, lda, b, ldb);
+		}
+		else if (rows >= cols)
+		{
+			// split on a multiple of the tile size, so that only the outer edges take the scalar path
+			const size_t half = (rows / 2 + Kernel::K - 1) / Kernel::K * Kernel::K;
+			TransposeRecursive<Kernel>(half, cols, a, lda, b, ldb);
+			TransposeRecursive<Kernel>(rows - half, cols, a + half * lda, lda, b + half, ldb);
+		}
+		else
+		{
+			const size_t half = (cols / 2 + Kernel::K - 1) / Kernel::K * Kernel::K;
+			TransposeRecursive<Kernel>(rows, half, a, lda, b, ldb);
+			TransposeRecursive<Kernel>(rows, cols - half, a + half, lda, b + half * ldb, ldb);
+		}
+	}
+
+	// B(0:cols, 0:rows) = A(0:rows, 0:cols)^T; A and B must not overlap.
+	// Under parallel policies, large arrays are split by rows of A across the worker threads.
+	template<typename Policy, typename T>
+	void Transpose(Policy policy, size_t rows, size_t cols, const T* a, size_t lda, T* b, size_t ldb)
+	{
+		const auto run = [=](auto kernel)
+		{
+			using Kernel = decltype(kernel);
+			if (IsParallel<T>(policy, rows * cols))
+			{
+				UTILITIES::ParallelFor(rows, TRANSPOSE_LEAF<T>, [=](size_t begin, size_t end)
+				{
+					TransposeRecursive<Kernel>(end - begin, cols, a + begin * lda, lda, b + begin, ldb);
+				});
+			}
+			else
+			{
+				TransposeRecursive<Kernel>(rows, cols, a, lda, b, ldb);
+			}
+		};
+#ifdef SEPOLIA4_X86_SIMD
+		if constexpr (Policy::VECTORIZED && IS_SIMD_TYPE<T>)
+		{
+			switch (UTILITIES::CpuFeatures::GetSimdLevel())
+			{
+				case UTILITIES::SimdLevel::AVX512:
+					return run(TransposeKernelAvx512<T>());
+				case UTILITIES::SimdLevel::AVX2:
+					return run(TransposeKernelAvx2<T>());
+				case UTILITIES::SimdLevel::SSE2:
+					return run(TransposeKernelSse2<T>());
+				default:
+					break;
+			}
+		}
+#endif
+		run(TransposeKernelScalar<T>());
+	}
+
+	//==========//
+	// In place //
+	//==========//
+
+	// A(0:n, 0:n) = A^T: the tiles above the diagonal swap with their mirror images through a buffer
+	template<typename Policy, typename T>
+	void TransposeSquareInPlace(Policy policy, size_t n, T* a, size_t lda)
+	{
+		constexpr size_t LEAF = TRANSPOSE_LEAF<T>;
+		using TilePolicy = std::conditional_t<Policy::VECTORIZED, EXECUTION::UnsequencedPolicy, EXECUTION::SequencedPolicy>;
+		const size_t blocks = (n + LEAF - 1) / LEAF;
+		const auto body = [=](size_t begin, size_t end)
+		{
+			std::vector<T> buffer(LEAF * LEAF);
+			for (size_t bi = begin; bi < end; bi++)
+			{
+				const size_t i = bi * LEAF;
+				const size_t rows = std::min(LEAF, n - i);
+				for (size_t j = i; j < n; j += LEAF)
+				{
+					const size_t cols = std::min(LEAF, n - j);
+					// buffer = A_ij^T, A_ij = A_ji^T, A_ji = buffer
+					Transpose(TilePolicy(), rows, cols, a + i * lda + j, lda, buffer.data(), rows);
+					if (j != i)
+					{
+						Transpose(TilePolicy(), cols, rows, a + j * lda + i, lda, a + i * lda + j, lda);
+					}
+					for (size_t r = 0; r < cols; r++)
+					{
+						std::copy_n(buffer.data() + r * rows, rows, a + (j + r) * lda + i);
+					}
+				}
+			}
+		};
+		// the rows of tiles get shorter down the diagonal: many small chunks even the load out
+		if (IsParallel<T>(policy, n * n)) UTILITIES::ParallelForChunks(blocks, blocks, 1, [&body](size_t, size_t begin, size_t end)
+		{
+			body(begin, end);
+		});
+		else body(0, blocks);
+	}
+
+	// the contiguous a[0, rows * cols) becomes its cols x rows transpose: element k moves to k * rows
+	// modulo rows * cols - 1, cycle by cycle, with one bit per element marking those already moved
+	template<typename T>
+	void TransposeInPlace(size_t rows, size_t cols, T* a)
+	{
+		const size_t size = rows * cols;
+		if (size < 3 || rows == 1 || cols == 1) return;
+		const size_t last = size - 1;
+		std::vector<bool> moved(size, false);
+		for (size_t start = 1; start < last; start++)
+		{
+			if (moved[start]) continue;
+			T carried = std::move(a[start]);
+			size_t k = start;
+			do
+			{
+				const size_t next = k * rows % last;
+				std::swap(carried, a[next]);
+				moved[next] = true;
+				k = next;
+			}
+			while (k != start);
+		}
+	}
+}
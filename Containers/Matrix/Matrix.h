@@ -1,45 +1,152 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 #include <iostream>
+#include "MatrixExpression.h"
+#include "MatrixView.h"
+#include "../Vector/VectorView.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../Memory/Uninitialized.h"
+#include "../Memory/FirstTouch.h"
+#include "../Memory/Padding.h"
+#include "../Kernels/SimdKernels.h"
+#include "../Kernels/ReductionKernels.h"
+#include "../Kernels/GemmKernels.h"
+#include "../Kernels/GemvKernels.h"
+#include "../Kernels/TransposeKernels.h"
+#include "../Kernels/BlasKernels.h"
+#include "../../Utilities/MappedFile.h"
 
 namespace SEPOLIA4::CONTAINERS
 {
-	template<typename T>
-	class Matrix final
+	// Order is ROW_MAJOR by default, or COLUMN_MAJOR to hand the storage to Fortran and LAPACK without copies
+	template<typename T, typename Allocator = AlignedAllocator<T>, StorageOrder Order = StorageOrder::ROW_MAJOR>
+	class Matrix final : public MatrixExpression<Matrix<T, Allocator, Order>>
 	{
+		using AllocatorTraits = std::allocator_traits<Allocator>;
+
 	public:
 
+		using ValueType = T;
+		using AllocatorType = Allocator;
+
+		static constexpr StorageOrder ORDER = Order;
+
 		//==============//
 		// Constructors //
 		//==============//
 
 		Matrix() = default;
 
-		explicit Matrix(uint32_t nrows, uint32_t ncols)
+		explicit Matrix(const Allocator& allocator) : m_allocator(allocator)
+		{
+		}
+
+		explicit Matrix(MatrixIndex nrows, MatrixIndex ncols)
 		{
 			Allocate(nrows, ncols);
 		}
 
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, const Allocator& allocator) : m_allocator(allocator)
+		{
+			Allocate(nrows, ncols);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, UninitializedTag)
+		{
+			AllocateUninitialized(nrows, ncols);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, UninitializedTag, const Allocator& allocator) : m_allocator(allocator)
+		{
+			AllocateUninitialized(nrows, ncols);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, ParallelFirstTouchTag)
+		{
+			Allocate(nrows, ncols, PARALLEL_FIRST_TOUCH);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, ParallelFirstTouchTag, const Allocator& allocator) : m_allocator(allocator)
+		{
+			Allocate(nrows, ncols, PARALLEL_FIRST_TOUCH);
+		}
+
+		// the rows (columns) are padded to PaddedLeadingDimension, also when the matrix is reallocated
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, PaddedTag) : m_padded(true)
+		{
+			Allocate(nrows, ncols);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, PaddedTag, const Allocator& allocator) : m_padded(true), m_allocator(allocator)
+		{
+			Allocate(nrows, ncols);
+		}
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, PaddedTag, UninitializedTag) : m_padded(true)
+		{
+			AllocateUninitialized(nrows, ncols);
+		}
+
+		//===================================================================//
+		// Matrices on a mapped file: the elements are the bytes of the file //
+		// from offset on, used in place, paged in on demand and never       //
+		// copied, so that they may be larger than RAM and shared by other   //
+		// processes (see UTILITIES::MappedFile). Every operation works on   //
+		// them; writes go to the file through READ_WRITE mappings and to    //
+		// private pages through COPY_ON_WRITE ones, which share the page    //
+		// cache until written. READ_ONLY mappings are rejected, since the   //
+		// matrix would fault on its first write: read them through a        //
+		// MatrixView<const T> on the file data instead. The matrix shares   //
+		// the ownership of the mapping, and moves to allocated storage when //
+		// it is reallocated; copies are allocated. Throws                   //
+		// std::invalid_argument for a READ_ONLY mapping, or when offset is  //
+		// misaligned for T or the file is too small.                        //
+		//===================================================================//
+
+		Matrix(MatrixIndex nrows, MatrixIndex ncols, std::shared_ptr<UTILITIES::MappedFile> file, size_t offset = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can live in a mapped file");
+			const size_t storageSize = static_cast<size_t>(nrows) * ncols;
+			if (!file || offset % alignof(T) != 0 || offset > file->Size() ||
+				(file->Size() - offset) / sizeof(T) < storageSize)
+			{
+				throw std::invalid_argument("Matrix: the file cannot hold the matrix at this offset");
+			}
+			if (file->GetMode() == UTILITIES::MapMode::READ_ONLY)
+			{
+				throw std::invalid_argument("Matrix: a read-only mapping cannot back a writable matrix");
+			}
+			m_data = storageSize == 0 ? nullptr : reinterpret_cast<T*>(file->Data() + offset);
+			m_nrows = nrows;
+			m_ncols = ncols;
+			m_ld = LineLength();
+			m_file = std::move(file);
+		}
+
 		explicit Matrix(const std::vector<std::vector<T>>& mat)
 		{
-			const auto NROWS = static_cast<uint32_t>(mat.size());
-			const auto NCOLS = static_cast<uint32_t>(mat[0].size());
-			Allocate(NROWS, NCOLS);
-			for (uint32_t i = 0; i < NROWS; i++)
+			const auto NROWS = static_cast<MatrixIndex>(mat.size());
+			const auto NCOLS = static_cast<MatrixIndex>(mat[0].size());
+			AllocateUninitialized(NROWS, NCOLS);
+			for (MatrixIndex i = 0; i < NROWS; i++)
 			{
-				for (uint32_t j = 0; j < NCOLS; j++)
+				for (MatrixIndex j = 0; j < NCOLS; j++)
 				{
-					m_data[static_cast<size_t>(i) * NCOLS + j] = mat[i][j];
+					m_data[Offset(i, j)] = mat[i][j];
 				}
 			}
 		}
 
 		Matrix(const std::initializer_list<std::initializer_list<T>>& initMatrix)
 		{
-			const uint32_t NROWS = initMatrix.size();
-			uint32_t NCOLS = 0;
+			const MatrixIndex NROWS = initMatrix.size();
+			MatrixIndex NCOLS = 0;
 			for(const auto& el1: initMatrix)
 			{
 				for(const auto& el2: el1)
@@ -50,53 +157,58 @@ namespace SEPOLIA4::CONTAINERS
 			}
 
 			Allocate(NROWS, NCOLS);
-			size_t idx = 0;
+			MatrixIndex i = 0;
 			for (const auto& el1 : initMatrix)
 			{
+				MatrixIndex j = 0;
 				for (const auto& el2 : el1)
 				{
-					m_data[idx] = el2;
-					idx++;
+					m_data[Offset(i, j)] = el2;
+					j++;
 				}
+				i++;
 			}
 		}
 
-		Matrix(const Matrix& other)
+		Matrix(const Matrix& other) :
+				m_padded(other.m_padded),
+				m_allocator(AllocatorTraits::select_on_container_copy_construction(other.m_allocator))
 		{
 			if (this != &other)
 			{
-				Allocate(other.m_nrows, other.m_ncols);
-				for (size_t i = 0; i < TotalElements(); i++)
-				{
-					m_data[i] = other.m_data[i];
-				}
+				AllocateUninitialized(other.m_nrows, other.m_ncols);
+				CopyElements(other);
 			}
 		}
 
+		// the matrix keeps its own padding
 		Matrix& operator=(const Matrix& other)
 		{
 			if (this != &other)
 			{
-				Allocate(other.m_nrows, other.m_ncols);
-				for (size_t i = 0; i < TotalElements(); i++)
+				if (m_nrows != other.m_nrows || m_ncols != other.m_ncols || !m_data)
 				{
-					m_data[i] = other.m_data[i];
+					AllocateUninitialized(other.m_nrows, other.m_ncols);
 				}
+				CopyElements(other);
 			}
 			return *this;
 		}
 
-		Matrix(Matrix&& other) noexcept
+		Matrix(Matrix&& other) noexcept : m_allocator(std::move(other.m_allocator))
 		{
 			if (this != &other)
 			{
-				if (m_data) Deallocate();
-				m_data = std::move(other.m_data);
+				m_data = other.m_data;
 				m_nrows = other.m_nrows;
 				m_ncols = other.m_ncols;
+				m_ld = other.m_ld;
+				m_padded = other.m_padded;
+				m_file = std::move(other.m_file);
 				other.m_data = nullptr;
 				other.m_nrows = 0;
 				other.m_ncols = 0;
+				other.m_ld = 0;
 			}
 		}
 
@@ -105,45 +217,113 @@ namespace SEPOLIA4::CONTAINERS
 			if (this != &other)
 			{
 				if (m_data) Deallocate();
-				m_data = std::move(other.m_data);
+				m_allocator = std::move(other.m_allocator);
+				m_data = other.m_data;
 				m_nrows = other.m_nrows;
 				m_ncols = other.m_ncols;
+				m_ld = other.m_ld;
+				m_padded = other.m_padded;
+				m_file = std::move(other.m_file);
 				other.m_data = nullptr;
 				other.m_nrows = 0;
 				other.m_ncols = 0;
+				other.m_ld = 0;
 			}
 			return *this;
 		}
 
-		~Matrix() = default;
+		// conversions from the other order go through KERNELS::Transpose; moves of square
+		// matrices take over the storage and swap its tiles in place, without a second buffer,
+		// while rectangular ones are transposed faster into new storage than along the cycles,
+		// and mapped ones too, so that the file keeps its layout
+		Matrix(Matrix<T, Allocator, TransposedOrder(Order)>&& other) : m_padded(other.m_padded), m_allocator(other.m_allocator)
+		{
+			if (other.m_nrows != other.m_ncols || other.m_file)
+			{
+				AllocateUninitialized(other.m_nrows, other.m_ncols);
+				Evaluate(EXECUTION::PAR_UNSEQ, other);
+				other.Deallocate();
+				return;
+			}
+			m_data = other.m_data;
+			m_nrows = other.m_nrows;
+			m_ncols = other.m_ncols;
+			m_ld = other.m_ld;
+			other.m_data = nullptr;
+			other.m_nrows = 0;
+			other.m_ncols = 0;
+			other.m_ld = 0;
+			KERNELS::TransposeSquareInPlace(EXECUTION::PAR_UNSEQ, m_nrows, m_data, m_ld);
+		}
+
+		Matrix& operator=(Matrix<T, Allocator, TransposedOrder(Order)>&& other)
+		{
+			return *this = Matrix(std::move(other));
+		}
+
+		template<typename E>
+		Matrix(const MatrixExpression<E>& expr)
+		{
+			const auto& e = expr.Derived();
+			AllocateUninitialized(e.NRows(), e.NCols());
+			Evaluate(EXECUTION::PAR_UNSEQ, e);
+		}
+
+		template<typename E>
+		Matrix& operator=(const MatrixExpression<E>& expr)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, expr);
+		}
+
+		~Matrix()
+		{
+			Deallocate();
+		}
 
 		//===================//
 		// Memory management //
 		//===================//
 
-		bool Allocate(uint32_t nrows, uint32_t ncols)
+		bool Allocate(MatrixIndex nrows, MatrixIndex ncols)
 		{
-			try
-			{
-				if (m_data) Deallocate();
-				m_data = std::make_unique<T[]>(nrows*ncols);
-				m_nrows = nrows;
-				m_ncols = ncols;
-				return true;
-			}
-			catch (std::exception& e)
-			{
-				m_data.reset(nullptr);
-				std::cout << e.what() << std::endl;
-			}
-			return false;
+			return AllocateStorage(nrows, ncols, Initialization::SERIAL);
+		}
+
+		// the elements are initialized in parallel, chunk by chunk, by the threads of the parallel kernels
+		bool Allocate(MatrixIndex nrows, MatrixIndex ncols, ParallelFirstTouchTag)
+		{
+			return AllocateStorage(nrows, ncols, Initialization::PARALLEL_FIRST_TOUCH);
+		}
+
+		// the elements of trivial types are left indeterminate: use it only when they are written next
+		bool AllocateUninitialized(MatrixIndex nrows, MatrixIndex ncols)
+		{
+			return AllocateStorage(nrows, ncols, std::is_trivially_default_constructible_v<T> ? Initialization::NONE : Initialization::SERIAL);
 		}
 
 		bool Deallocate()
 		{
-			m_data.reset(nullptr);
+			if (m_file)
+			{
+				// the mapping goes away with its last owner
+				m_file.reset();
+			}
+			else if (m_data)
+			{
+				const size_t storageSize = StorageSize();
+				if constexpr (!std::is_trivially_destructible_v<T>)
+				{
+					for (size_t i = 0; i < storageSize; i++)
+					{
+						AllocatorTraits::destroy(m_allocator, m_data + i);
+					}
+				}
+				AllocatorTraits::deallocate(m_allocator, m_data, storageSize);
+			}
+			m_data = nullptr;
 			m_nrows = 0;
 			m_ncols = 0;
+			m_ld = 0;
 			return true;
 		}
 
@@ -158,190 +338,349 @@ namespace SEPOLIA4::CONTAINERS
 			return !IsAllocated();
 		}
 
+		// true when the elements live in a mapped file
+		[[nodiscard]] bool IsMapped() const
+		{
+			return m_file != nullptr;
+		}
+
+		// the mapping the elements live in, if any: use it for access hints (MappedFile::Advise) and Sync
+		[[nodiscard]] const std::shared_ptr<UTILITIES::MappedFile>& GetMappedFile() const
+		{
+			return m_file;
+		}
+
 		//======================================//
 		// Operators to access and set elements //
 		//======================================//
 
-		[[nodiscard]] const T& At(uint32_t rowIdx, uint32_t colIdx) const
+		[[nodiscard]] const T& At(MatrixIndex rowIdx, MatrixIndex colIdx) const
 		{
-			return m_data[rowIdx * static_cast<size_t>(m_ncols) + colIdx];
+			return m_data[Offset(rowIdx, colIdx)];
 		}
 
-		T& operator()(uint32_t rowIdx, uint32_t colIdx)
+		T& operator()(MatrixIndex rowIdx, MatrixIndex colIdx)
 		{
-			return m_data[rowIdx * static_cast<size_t>(m_ncols) + colIdx];
+			return m_data[Offset(rowIdx, colIdx)];
 		}
 
-		//================//
-		// Check equality //
-		//================//
+		// element idx in the storage order
+		const T& operator[](size_t idx) const
+		{
+			if (IsContiguous()) return m_data[idx];
+			return m_data[idx / LineLength() * m_ld + idx % LineLength()];
+		}
 
-		bool operator==(const Matrix& rhs) const
+		T* Data()
 		{
-			if (m_ncols != rhs.m_ncols) return false;
-			if (m_nrows != rhs.m_nrows) return false;
+			return m_data;
+		}
 
-			for (size_t i = 0; i < TotalElements(); i++)
-			{
-				if (m_data[i] != rhs.m_data[i]) return false;
-			}
-			return true;
+		[[nodiscard]] const T* Data() const
+		{
+			return m_data;
+		}
+
+		// view of the nrows x ncols block whose top left element is (rowIdx, colIdx), with leading dimension LeadingDimension()
+		[[nodiscard]] MatrixView<T, Order> Block(MatrixIndex rowIdx, MatrixIndex colIdx, MatrixIndex nrows, MatrixIndex ncols)
+		{
+			return MatrixView<T, Order>(m_data + Offset(rowIdx, colIdx), nrows, ncols, LeadingDimension());
 		}
 
-		bool operator==(T val) const
+		[[nodiscard]] MatrixView<const T, Order> Block(MatrixIndex rowIdx, MatrixIndex colIdx, MatrixIndex nrows, MatrixIndex ncols) const
 		{
-			for (size_t i = 0; i < TotalElements(); i++)
+			return MatrixView<const T, Order>(m_data + Offset(rowIdx, colIdx), nrows, ncols, LeadingDimension());
+		}
+
+		//=================================================================//
+		// Transposes through the cache-oblivious SIMD kernels of          //
+		// KERNELS::Transpose. In place, square matrices swap tiles across //
+		// the diagonal and rectangular ones follow the permutation cycles //
+		// on one thread, with one bit of extra memory per element, and    //
+		// padded ones are transposed into new storage.                    //
+		//=================================================================//
+
+		template<typename Policy>
+		[[nodiscard]] Matrix Transposed(Policy policy) const
+		{
+			Matrix res(m_allocator);
+			res.m_padded = m_padded;
+			res.AllocateUninitialized(m_ncols, m_nrows);
+			KERNELS::Transpose(policy, Lines(), LineLength(), m_data, m_ld, res.m_data, res.m_ld);
+			return res;
+		}
+
+		[[nodiscard]] Matrix Transposed() const
+		{
+			return Transposed(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		Matrix& TransposeInPlace(Policy policy)
+		{
+			if (m_nrows == m_ncols)
 			{
-				if (m_data[i] != val) return false;
+				KERNELS::TransposeSquareInPlace(policy, m_nrows, m_data, m_ld);
 			}
-			return true;
+			else if (!m_padded)
+			{
+				KERNELS::TransposeInPlace(Lines(), LineLength(), m_data);
+				std::swap(m_nrows, m_ncols);
+				m_ld = LineLength();
+			}
+			else
+			{
+				// the transposed lines take another padding
+				*this = Transposed(policy);
+			}
+			return *this;
 		}
 
-		template<typename U>
-		friend bool operator==(U val, const Matrix<U>& rhs)
+		Matrix& TransposeInPlace()
 		{
-			return rhs == val;
+			return TransposeInPlace(EXECUTION::PAR_UNSEQ);
 		}
 
-		bool operator!=(const Matrix& rhs) const
+		//===================================================================//
+		// Views of a row, a column and the main diagonal, without copies.   //
+		// Rows are contiguous in ROW_MAJOR and columns in COLUMN_MAJOR, the //
+		// others and the diagonal are strided.                              //
+		//===================================================================//
+
+		[[nodiscard]] VectorView<T> Row(MatrixIndex rowIdx)
 		{
-			return !(*this == rhs);
+			return VectorView<T>(m_data + Offset(rowIdx, 0), m_ncols, RowStride());
 		}
 
-		bool operator!=(T val) const
+		[[nodiscard]] VectorView<const T> Row(MatrixIndex rowIdx) const
 		{
-			return !(*this == val);
+			return VectorView<const T>(m_data + Offset(rowIdx, 0), m_ncols, RowStride());
 		}
 
-		template<typename U>
-		friend bool operator!=(U val, const Matrix<U>& rhs)
+		[[nodiscard]] VectorView<T> Col(MatrixIndex colIdx)
 		{
-			return rhs != val;
+			return VectorView<T>(m_data + Offset(0, colIdx), m_nrows, ColStride());
 		}
 
-		//======================//
-		// arithmetic operators //
-		//======================//
+		[[nodiscard]] VectorView<const T> Col(MatrixIndex colIdx) const
+		{
+			return VectorView<const T>(m_data + Offset(0, colIdx), m_nrows, ColStride());
+		}
 
-		//=============//
-		// operator: + //
-		//=============//
+		[[nodiscard]] VectorView<T> Diagonal()
+		{
+			return VectorView<T>(m_data, std::min(m_nrows, m_ncols), LeadingDimension() + 1);
+		}
 
-		Matrix operator+(const Matrix& rhs) const
+		[[nodiscard]] VectorView<const T> Diagonal() const
 		{
-			Matrix<T> res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
-			{
-				res.m_data[i] = m_data[i] + rhs.m_data[i];
-			}
-			return std::move(res);
+			return VectorView<const T>(m_data, std::min(m_nrows, m_ncols), LeadingDimension() + 1);
 		}
 
-		Matrix operator+(T val) const
+		//=================================================================//
+		// Reductions over all the elements. Without a policy argument     //
+		// they use PAR_UNSEQ. Min, Max and MinMax need a non-empty matrix //
+		//=================================================================//
+
+		template<typename Policy>
+		[[nodiscard]] T Sum(Policy policy, Summation summation = Summation::FAST) const
 		{
-			Matrix<T> res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
-			{
-				res.m_data[i] = m_data[i] + val;
-			}
-			return std::move(res);
+			if (!IsContiguous()) return View().Sum(policy, summation);
+			return KERNELS::SumAll(policy, m_data, TotalElements(), summation);
 		}
 
-		template<typename U>
-		friend Matrix<U> operator+(U val, const Matrix<U>& rhs)
+		[[nodiscard]] T Sum(Summation summation = Summation::FAST) const
 		{
-			Matrix<T> res;
-			res.Allocate(rhs.m_nrows, rhs.m_ncols);
-			for (size_t i = 0; i < res.TotalElements(); i++)
-			{
-				res.m_data[i] = val + rhs.m_data[i];
-			}
-			return std::move(res);
+			return Sum(EXECUTION::PAR_UNSEQ, summation);
 		}
 
-		void operator++()
+		template<typename Policy>
+		[[nodiscard]] T FrobeniusNorm(Policy policy) const
+		{
+			if (!IsContiguous()) return View().FrobeniusNorm(policy);
+			return static_cast<T>(std::sqrt(KERNELS::DotAll(policy, m_data, m_data, TotalElements())));
+		}
+
+		[[nodiscard]] T FrobeniusNorm() const
+		{
+			return FrobeniusNorm(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] T Min(Policy policy) const
+		{
+			if (!IsContiguous()) return View().Min(policy);
+			return KERNELS::ReduceAll<OPERATIONS::Min>(policy, m_data, TotalElements());
+		}
+
+		[[nodiscard]] T Min() const
+		{
+			return Min(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] T Max(Policy policy) const
+		{
+			if (!IsContiguous()) return View().Max(policy);
+			return KERNELS::ReduceAll<OPERATIONS::Max>(policy, m_data, TotalElements());
+		}
+
+		[[nodiscard]] T Max() const
+		{
+			return Max(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] std::pair<T, T> MinMax(Policy policy) const
+		{
+			if (!IsContiguous()) return View().MinMax(policy);
+			return KERNELS::MinMaxAll(policy, m_data, TotalElements());
+		}
+
+		[[nodiscard]] std::pair<T, T> MinMax() const
 		{
-			for (size_t i = 0; i < TotalElements(); i++)
+			return MinMax(EXECUTION::PAR_UNSEQ);
+		}
+
+		//==================================================================//
+		// Operations with an execution policy (EXECUTION::SEQ, UNSEQ, PAR, //
+		// PAR_UNSEQ). The operators below are these with PAR_UNSEQ.        //
+		// Assign(policy, other) with another Matrix is a copy.             //
+		//==================================================================//
+
+		template<typename Policy, typename E>
+		Matrix& Assign(Policy policy, const MatrixExpression<E>& expr)
+		{
+			const auto& e = expr.Derived();
+			if (m_nrows == e.NRows() && m_ncols == e.NCols())
 			{
-				m_data[i]++;
+				// elementwise expressions only read index i to write index i, so they can be evaluated
+				// straight into the existing storage; transposed views of it are detected and go aside.
+				// Larger expressions must not read other elements of this matrix (a transposed view of
+				// it plus another operand, a shifted block of it): evaluate them into a new matrix
+				Evaluate(policy, e);
 			}
+			else
+			{
+				// the expression may refer to this matrix: build aside, then move in
+				Matrix res(m_allocator);
+				res.m_padded = m_padded;
+				res.AllocateUninitialized(e.NRows(), e.NCols());
+				res.Evaluate(policy, e);
+				*this = std::move(res);
+			}
+			return *this;
 		}
 
-		void operator++(int)
+		template<typename Policy, typename E>
+		Matrix& Add(Policy policy, const MatrixExpression<E>& rhs)
 		{
-			++(*this);
+			CompoundAssign<OPERATIONS::Plus>(policy, rhs.Derived());
+			return *this;
 		}
 
-		Matrix& operator+=(const Matrix& rhs)
+		template<typename Policy>
+		Matrix& Add(Policy policy, T val)
 		{
-			*this = *this + rhs;
+			CompoundAssignScalar<OPERATIONS::Plus>(policy, val);
 			return *this;
 		}
 
-		Matrix& operator+=(T val)
+		template<typename Policy, typename E>
+		Matrix& Subtract(Policy policy, const MatrixExpression<E>& rhs)
 		{
-			*this = *this + val;
+			CompoundAssign<OPERATIONS::Minus>(policy, rhs.Derived());
 			return *this;
 		}
 
-		//=============//
-		// operator: - //
-		//=============//
+		template<typename Policy>
+		Matrix& Subtract(Policy policy, T val)
+		{
+			CompoundAssignScalar<OPERATIONS::Minus>(policy, val);
+			return *this;
+		}
 
-		Matrix operator-(const Matrix& rhs) const
+		template<typename Policy, typename E>
+		Matrix& Multiply(Policy policy, const MatrixExpression<E>& rhs)
 		{
-			Matrix res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
-			{
-				res.m_data[i] = m_data[i] - rhs.m_data[i];
-			}
-			return std::move(res);
+			CompoundAssign<OPERATIONS::Multiplies>(policy, rhs.Derived());
+			return *this;
 		}
 
-		Matrix operator-(T val) const
+		template<typename Policy>
+		Matrix& Multiply(Policy policy, T val)
 		{
-			Matrix res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
-			{
-				res.m_data[i] = m_data[i] - val;
-			}
-			return std::move(res);
+			CompoundAssignScalar<OPERATIONS::Multiplies>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		Matrix& Divide(Policy policy, const MatrixExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Divides>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		Matrix& Divide(Policy policy, T val)
+		{
+			CompoundAssignScalar<OPERATIONS::Divides>(policy, val);
+			return *this;
 		}
 
-		template<typename U>
-		friend Matrix<U> operator-(U val, const Matrix<U>& rhs)
+		template<typename Policy>
+		Matrix& Fill(Policy policy, T val)
 		{
-			Matrix<T> res;
-			res.Allocate(rhs.m_nrows, rhs.m_ncols);
-			for (size_t i = 0; i < rhs.TotalElements(); i++)
+			T* const data = m_data;
+			ForRuns(policy, [data, val](size_t offset, size_t n)
 			{
-				res.m_data[i] = val - rhs.m_data[i];
-			}
-			return std::move(res);
+				std::fill_n(data + offset, n, val);
+			});
+			return *this;
 		}
 
-		template<typename U>
-		friend Matrix<U> operator-(const Matrix<U>& rhs)
+		//===============================//
+		// Compound assignment operators //
+		//===============================//
+
+		void operator++()
 		{
-			Matrix<T> res;
-			res.Allocate(rhs.m_nrows, rhs.m_ncols);
-			for (size_t i = 0; i < rhs.TotalElements(); i++)
+			T* const data = m_data;
+			ForRuns(EXECUTION::SEQ, [data](size_t offset, size_t n)
 			{
-				res.m_data[i] = -rhs.m_data[i];
-			}
-			return std::move(res);
+				for (size_t i = offset; i < offset + n; i++)
+				{
+					data[i]++;
+				}
+			});
+		}
+
+		void operator++(int)
+		{
+			++(*this);
+		}
+
+		template<typename E>
+		Matrix& operator+=(const MatrixExpression<E>& rhs)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		Matrix& operator+=(T val)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, val);
 		}
 
 		void operator--()
 		{
-			for (size_t i = 0; i < TotalElements(); i++)
+			T* const data = m_data;
+			ForRuns(EXECUTION::SEQ, [data](size_t offset, size_t n)
 			{
-				m_data[i]--;
-			}
+				for (size_t i = offset; i < offset + n; i++)
+				{
+					data[i]--;
+				}
+			});
 		}
 
 		void operator--(int)
@@ -349,150 +688,619 @@ namespace SEPOLIA4::CONTAINERS
 			--(*this);
 		}
 
-		Matrix& operator-=(const Matrix& rhs)
+		template<typename E>
+		Matrix& operator-=(const MatrixExpression<E>& rhs)
 		{
-			*this = *this - rhs;
-			return *this;
+			return Subtract(EXECUTION::PAR_UNSEQ, rhs);
 		}
 
 		Matrix& operator-=(T val)
 		{
-			*this = *this - val;
-			return *this;
+			return Subtract(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		Matrix& operator*=(const MatrixExpression<E>& rhs)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		Matrix& operator*=(T val)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		Matrix& operator/=(const MatrixExpression<E>& rhs)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		Matrix& operator/=(T val)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		//============================//
+		// Assignment value operators //
+		//============================//
+
+		Matrix& operator=(T val)
+		{
+			return Fill(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		[[nodiscard]] size_t TotalElements() const
+		{
+			return static_cast<size_t>(m_nrows) * m_ncols;
 		}
 
-		//=============//
-		// operator: * //
-		//=============//
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_nrows;
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_ncols;
+		}
+
+		// distance, in elements, between the starts of consecutive rows (columns for COLUMN_MAJOR)
+		[[nodiscard]] size_t LeadingDimension() const
+		{
+			return m_ld;
+		}
+
+		[[nodiscard]] bool IsPadded() const
+		{
+			return m_padded;
+		}
+
+		// true when the rows (columns) follow each other without padding
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_ld == LineLength() || Lines() <= 1;
+		}
+
+		[[nodiscard]] Allocator GetAllocator() const
+		{
+			return m_allocator;
+		}
+
+	private:
+
+		template<typename U, typename A, StorageOrder>
+		friend class Matrix;
+
+		enum class Initialization
+		{
+			NONE,
+			SERIAL,
+			PARALLEL_FIRST_TOUCH
+		};
 
-		Matrix operator*(const Matrix& rhs) const
+		bool AllocateStorage(MatrixIndex nrows, MatrixIndex ncols, Initialization initialization)
 		{
-			Matrix res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
+			try
 			{
-				res.m_data[i] = m_data[i] * rhs.m_data[i];
+				if (m_data) Deallocate();
+				const size_t lines = Order == StorageOrder::ROW_MAJOR ? nrows : ncols;
+				const size_t lineLength = Order == StorageOrder::ROW_MAJOR ? ncols : nrows;
+				const size_t ld = m_padded ? PaddedLeadingDimension<T>(lineLength) : lineLength;
+				const size_t storageSize = lines * ld;
+				m_data = AllocatorTraits::allocate(m_allocator, storageSize);
+				if (initialization == Initialization::SERIAL)
+				{
+					for (size_t i = 0; i < storageSize; i++)
+					{
+						AllocatorTraits::construct(m_allocator, m_data + i);
+					}
+				}
+				else if (initialization == Initialization::PARALLEL_FIRST_TOUCH)
+				{
+					ParallelFirstTouch(m_allocator, m_data, storageSize);
+				}
+				m_nrows = nrows;
+				m_ncols = ncols;
+				m_ld = ld;
+				return true;
 			}
-			return std::move(res);
+			catch (std::exception& e)
+			{
+				m_data = nullptr;
+				std::cout << e.what() << std::endl;
+			}
+			return false;
+		}
+
+		//==================================================================//
+		// Layout: the storage is Lines() lines of LineLength() elements,   //
+		// the rows of a ROW_MAJOR matrix and the columns of a COLUMN_MAJOR //
+		// one, which start LeadingDimension() elements apart.              //
+		//==================================================================//
+
+		[[nodiscard]] MatrixIndex Lines() const
+		{
+			return Order == StorageOrder::ROW_MAJOR ? m_nrows : m_ncols;
+		}
+
+		[[nodiscard]] MatrixIndex LineLength() const
+		{
+			return Order == StorageOrder::ROW_MAJOR ? m_ncols : m_nrows;
+		}
+
+		[[nodiscard]] size_t Offset(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			if constexpr (Order == StorageOrder::ROW_MAJOR) return rowIdx * m_ld + colIdx;
+			else return colIdx * m_ld + rowIdx;
 		}
 
-		Matrix operator*(T val) const
+		[[nodiscard]] size_t StorageSize() const
 		{
-			Matrix<T> res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
+			return static_cast<size_t>(Lines()) * m_ld;
+		}
+
+		[[nodiscard]] MatrixView<const T, Order> View() const
+		{
+			return MatrixView<const T, Order>(m_data, m_nrows, m_ncols, m_ld);
+		}
+
+		// body(offset, n) on runs of n elements stored back to back that cover the matrix: chunks of the
+		// whole storage without padding, the lines otherwise, on the worker threads under parallel policies
+		template<typename Policy, typename F>
+		void ForRuns(Policy policy, F&& body) const
+		{
+			if (IsContiguous())
 			{
-				res.m_data[i] = m_data[i] * val;
+				KERNELS::ForChunks<T>(policy, TotalElements(), [&body](size_t begin, size_t end)
+				{
+					body(begin, end - begin);
+				});
+				return;
 			}
-			return std::move(res);
+
+			const size_t ld = m_ld;
+			const size_t n = LineLength();
+			KERNELS::ForRows<T>(policy, Lines(), n, [&body, ld, n](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					body(i * ld, n);
+				}
+			});
 		}
 
-		template<typename U>
-		friend Matrix<U> operator*(U val, const Matrix<U>& rhs)
+		// the elements of a matrix of the same dimensions, line by line when either one is padded
+		void CopyElements(const Matrix& other)
 		{
-			Matrix<U> res;
-			res.Allocate(rhs.m_nrows, rhs.m_ncols);
-			for (size_t i = 0; i < rhs.TotalElements(); i++)
+			const size_t n = LineLength();
+			for (size_t i = 0; i < Lines(); i++)
 			{
-				res.m_data[i] = val * rhs.m_data[i];
+				for (size_t k = 0; k < n; k++)
+				{
+					m_data[i * m_ld + k] = other.m_data[i * other.m_ld + k];
+				}
 			}
-			return std::move(res);
 		}
 
-		Matrix& operator*=(const Matrix& rhs)
+		[[nodiscard]] size_t RowStride() const
 		{
-			*this = *this * rhs;
-			return *this;
+			return Order == StorageOrder::ROW_MAJOR ? 1 : LeadingDimension();
 		}
 
-		Matrix& operator*=(T val)
+		[[nodiscard]] size_t ColStride() const
 		{
-			*this = *this * val;
-			return *this;
+			return Order == StorageOrder::ROW_MAJOR ? LeadingDimension() : 1;
+		}
+
+		// element k of line i of an expression of the same dimensions
+		template<typename E>
+		static auto LineElement(const E& e, MatrixIndex i, MatrixIndex k)
+		{
+			if constexpr (Order == StorageOrder::ROW_MAJOR) return e.At(i, k);
+			else return e.At(k, i);
+		}
+
+		//========================================//
+		// Fused evaluation of an expression tree //
+		//========================================//
+
+		// large matrices are evaluated chunk by chunk on the worker threads under parallel policies,
+		// line by line through At when the expression reads views with gaps between the lines or
+		// operands in the other order, and matrices and views in the other order are transposed
+
+		// true when the size elements from ptr on share memory with the storage of this matrix
+		[[nodiscard]] bool Overlaps(const T* ptr, size_t size) const
+		{
+			if (!m_data || size == 0) return false;
+			const std::less<const T*> less;
+			return less(ptr, m_data + StorageSize()) && less(m_data, ptr + size);
 		}
 
-		//=============//
-		// operator: / //
-		//=============//
+		// the transpose of the lines of src, which overlap this matrix: a view of the whole square
+		// storage is transposed in place, any other through a temporary buffer copied back line by line
+		template<typename Policy>
+		void EvaluateTransposedAlias(Policy policy, const T* src, size_t srcLd)
+		{
+			if (src == m_data && srcLd == m_ld && m_nrows == m_ncols)
+			{
+				KERNELS::TransposeSquareInPlace(policy, m_nrows, m_data, m_ld);
+				return;
+			}
+			const size_t lineLength = LineLength();
+			std::vector<T, AlignedAllocator<T>> buffer(static_cast<size_t>(Lines()) * lineLength);
+			KERNELS::Transpose(policy, lineLength, Lines(), src, srcLd, buffer.data(), lineLength);
+			for (size_t i = 0; i < Lines(); i++)
+			{
+				std::copy_n(buffer.data() + i * lineLength, lineLength, m_data + i * m_ld);
+			}
+		}
 
-		Matrix operator/(const Matrix& rhs) const
+		template<typename Policy, typename E>
+		void Evaluate(Policy policy, const E& e)
 		{
-			Matrix<T> res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < rhs.TotalElements(); i++)
+			T* const data = m_data;
+			if constexpr (E::ORDER != Order && (IsMatrixLeaf<E>::value || IsMatrixView<E>::value) &&
+						  std::is_same_v<typename E::ValueType, T>)
 			{
-				res.m_data[i] = m_data[i] / rhs.m_data[i];
+				if (TotalElements() > 0 && Overlaps(e.Data(), static_cast<size_t>(LineLength() - 1) * e.LeadingDimension() + Lines()))
+				{
+					EvaluateTransposedAlias(policy, e.Data(), e.LeadingDimension());
+					return;
+				}
+				KERNELS::Transpose(policy, LineLength(), Lines(), e.Data(), e.LeadingDimension(), data, LeadingDimension());
+				return;
+			}
+			else if (E::ORDER == Order && IsContiguous() && e.IsContiguous())
+			{
+				KERNELS::ForChunks<T>(policy, TotalElements(), [data, &e](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						data[i] = e[i];
+					}
+				});
+				return;
 			}
-			return std::move(res);
+
+			const MatrixIndex n = LineLength();
+			const size_t ld = m_ld;
+			KERNELS::ForRows<T>(policy, Lines(), n, [data, n, ld, &e](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					for (MatrixIndex k = 0; k < n; k++)
+					{
+						data[i * ld + k] = LineElement(e, static_cast<MatrixIndex>(i), k);
+					}
+				}
+			});
 		}
 
-		Matrix operator/(T val) const
+		// single-operation expressions on whole matrices go to the SIMD kernels, run by run when
+		// the operands are laid out alike and through the line-by-line kernels of MatrixView otherwise
+
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const MatrixBinaryExpression<Matrix, Matrix, Op>& e)
 		{
-			Matrix<T> res;
-			res.Allocate(m_nrows, m_ncols);
-			for (size_t i = 0; i < TotalElements(); i++)
+			if (e.Lhs().m_ld != m_ld || e.Rhs().m_ld != m_ld)
 			{
-				res.m_data[i] = m_data[i] / val;
+				MatrixView<T, Order>(m_data, m_nrows, m_ncols, m_ld).Assign(policy, e);
+				return;
 			}
-			return std::move(res);
+			const T* const a = e.Lhs().Data();
+			const T* const b = e.Rhs().Data();
+			T* const c = m_data;
+			ForRuns(policy, [policy, a, b, c](size_t offset, size_t n)
+			{
+				KERNELS::Binary<Op>(policy, a + offset, b + offset, c + offset, n);
+			});
 		}
 
-		template<typename U>
-		friend Matrix<U> operator/(U val, const Matrix<U>& rhs)
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const MatrixScalarExpression<Matrix, Op>& e)
 		{
-			Matrix<U> res;
-			res.Allocate(rhs.m_nrows, rhs.m_ncols);
-			for (size_t i = 0; i < rhs.TotalElements(); i++)
+			if (e.Lhs().m_ld != m_ld)
 			{
-				res.m_data[i] = val / rhs.m_data[i];
+				MatrixView<T, Order>(m_data, m_nrows, m_ncols, m_ld).Assign(policy, e);
+				return;
 			}
-			return std::move(res);
+			const T* const a = e.Lhs().Data();
+			const T val = e.Scalar();
+			T* const c = m_data;
+			ForRuns(policy, [policy, a, val, c](size_t offset, size_t n)
+			{
+				KERNELS::Binary<Op>(policy, a + offset, val, c + offset, n);
+			});
 		}
 
-		Matrix& operator/=(const Matrix& rhs)
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const ScalarMatrixExpression<Matrix, Op>& e)
 		{
-			*this = *this / rhs;
-			return *this;
+			if (e.Rhs().m_ld != m_ld)
+			{
+				MatrixView<T, Order>(m_data, m_nrows, m_ncols, m_ld).Assign(policy, e);
+				return;
+			}
+			const T val = e.Scalar();
+			const T* const b = e.Rhs().Data();
+			T* const c = m_data;
+			ForRuns(policy, [policy, val, b, c](size_t offset, size_t n)
+			{
+				KERNELS::Binary<Op>(policy, val, b + offset, c + offset, n);
+			});
 		}
 
-		Matrix& operator/=(T val)
+		//======================================//
+		// In-place compound assignment kernels //
+		//======================================//
+
+		template<typename Op, typename Policy, typename E>
+		void CompoundAssign(Policy policy, const E& e)
 		{
-			*this = *this / val;
-			return *this;
+			T* const data = m_data;
+			if (E::ORDER == Order && IsContiguous() && e.IsContiguous())
+			{
+				KERNELS::ForChunks<T>(policy, TotalElements(), [data, &e](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						data[i] = Op::Apply(data[i], e[i]);
+					}
+				});
+				return;
+			}
+
+			const MatrixIndex n = LineLength();
+			const size_t ld = m_ld;
+			KERNELS::ForRows<T>(policy, Lines(), n, [data, n, ld, &e](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					for (MatrixIndex k = 0; k < n; k++)
+					{
+						data[i * ld + k] = Op::Apply(data[i * ld + k], LineElement(e, static_cast<MatrixIndex>(i), k));
+					}
+				}
+			});
 		}
 
-		//============================//
-		// Assignment value operators //
-		//============================//
+		template<typename Op, typename Policy>
+		void CompoundAssign(Policy policy, const Matrix& m)
+		{
+			const T* const b = m.Data();
+			T* const c = m_data;
+			if (m.m_ld == m_ld)
+			{
+				ForRuns(policy, [policy, b, c](size_t offset, size_t n)
+				{
+					KERNELS::Binary<Op>(policy, c + offset, b + offset, c + offset, n);
+				});
+				return;
+			}
 
-		Matrix& operator=(T val)
+			const size_t ldb = m.m_ld;
+			const size_t ldc = m_ld;
+			const size_t n = LineLength();
+			KERNELS::ForRows<T>(policy, Lines(), n, [policy, b, c, ldb, ldc, n](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					KERNELS::Binary<Op>(policy, c + i * ldc, b + i * ldb, c + i * ldc, n);
+				}
+			});
+		}
+
+		template<typename Op, typename Policy>
+		void CompoundAssignScalar(Policy policy, T val)
 		{
-			for (size_t i = 0; i < TotalElements(); i++)
+			T* const c = m_data;
+			if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>)
 			{
-				m_data[i] = val;
+				// as in Vector: scaling by 0 stays native for the NaNs and infinities
+				const size_t n = TotalElements();
+				if (val != T(0) && IsContiguous() && KERNELS::UseBlas<T>(policy, n, KERNELS::BLAS_MIN_LEVEL1_SIZE, n))
+				{
+					KERNELS::BlasScal(n, val, c, 1);
+					return;
+				}
 			}
-			return *this;
+			ForRuns(policy, [policy, val, c](size_t offset, size_t n)
+			{
+				KERNELS::Binary<Op>(policy, c + offset, val, c + offset, n);
+			});
 		}
 
-		[[nodiscard]] size_t TotalElements() const
+		T* m_data = nullptr;
+		MatrixIndex m_nrows = 0;
+		MatrixIndex m_ncols = 0;
+		size_t m_ld = 0;
+		bool m_padded = false;
+		Allocator m_allocator;
+		std::shared_ptr<UTILITIES::MappedFile> m_file;
+	};
+
+	template<typename T, typename Allocator = AlignedAllocator<T>>
+	using ColumnMajorMatrix = Matrix<T, Allocator, StorageOrder::COLUMN_MAJOR>;
+
+	//================================================================//
+	// Matrix product: operator* stays the elementwise product, while //
+	// Gemm and MatMul run the cache-blocked, packed SIMD kernels of  //
+	// KERNELS::Gemm, on the worker threads for large products under  //
+	// parallel policies, or BLAS for large float and double products //
+	// under PAR_UNSEQ, the policy without an argument.               //
+	// Views pass blocks of larger matrices in place. Column-major    //
+	// operands are the row-major transposes of the same memory, so   //
+	// they go to the same kernels through the identities             //
+	// C^T = B^T * A^T and (A^T)^T = A, without copies.               //
+	//================================================================//
+
+	// c = alpha * a * b + beta * c; T follows alpha (1.0f for float matrices), c must not overlap a or b
+	template<typename T, typename Policy>
+	void Gemm(Policy policy, T alpha, typename TypeIdentity<MatrixView<const T>>::Type a,
+			typename TypeIdentity<MatrixView<const T>>::Type b, T beta, typename TypeIdentity<MatrixView<T>>::Type c)
+	{
+		if (a.NCols() != b.NRows() || c.NRows() != a.NRows() || c.NCols() != b.NCols())
 		{
-			return static_cast<size_t>(m_nrows) * m_ncols;
+			throw std::invalid_argument("Gemm: the dimensions of the matrices do not match");
 		}
+		const size_t m = c.NRows();
+		const size_t n = c.NCols();
+		const size_t k = a.NCols();
+		if (KERNELS::UseBlas<T>(policy, m * n * k, KERNELS::BLAS_MIN_GEMM_SIZE, m, n, k,
+				a.LeadingDimension(), b.LeadingDimension(), c.LeadingDimension()))
+		{
+			KERNELS::BlasGemm<T>(m, n, k, alpha, a.Data(), a.LeadingDimension(),
+					b.Data(), b.LeadingDimension(), beta, c.Data(), c.LeadingDimension());
+			return;
+		}
+		KERNELS::Gemm<T>(policy, m, n, k, alpha, a.Data(), a.LeadingDimension(),
+				b.Data(), b.LeadingDimension(), beta, c.Data(), c.LeadingDimension());
+	}
+
+	template<typename T, typename Policy>
+	void Gemm(Policy policy, T alpha, typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type b, T beta,
+			typename TypeIdentity<MatrixView<T, StorageOrder::COLUMN_MAJOR>>::Type c)
+	{
+		if (a.NCols() != b.NRows() || c.NRows() != a.NRows() || c.NCols() != b.NCols())
+		{
+			throw std::invalid_argument("Gemm: the dimensions of the matrices do not match");
+		}
+		Gemm<T>(policy, alpha, b.Transposed(), a.Transposed(), beta, c.Transposed());
+	}
 
-		[[nodiscard]] uint32_t NRows() const
+	template<typename T>
+	void Gemm(T alpha, typename TypeIdentity<MatrixView<const T>>::Type a, typename TypeIdentity<MatrixView<const T>>::Type b,
+			T beta, typename TypeIdentity<MatrixView<T>>::Type c)
+	{
+		Gemm<T>(EXECUTION::PAR_UNSEQ, alpha, a, b, beta, c);
+	}
+
+	template<typename T>
+	void Gemm(T alpha, typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type b, T beta,
+			typename TypeIdentity<MatrixView<T, StorageOrder::COLUMN_MAJOR>>::Type c)
+	{
+		Gemm<T>(EXECUTION::PAR_UNSEQ, alpha, a, b, beta, c);
+	}
+
+	// the matrix product a * b
+	template<typename Policy, typename T, typename Allocator, StorageOrder Order>
+	Matrix<T, Allocator, Order> MatMul(Policy policy, const Matrix<T, Allocator, Order>& a, const Matrix<T, Allocator, Order>& b)
+	{
+		if (a.NCols() != b.NRows())
 		{
-			return m_nrows;
+			throw std::invalid_argument("MatMul: the dimensions of the matrices do not match");
 		}
+		Matrix<T, Allocator, Order> c(a.NRows(), b.NCols(), UNINITIALIZED, a.GetAllocator());
+		Gemm<T>(policy, T(1), a, b, T(0), c);
+		return c;
+	}
+
+	template<typename T, typename Allocator, StorageOrder Order>
+	Matrix<T, Allocator, Order> MatMul(const Matrix<T, Allocator, Order>& a, const Matrix<T, Allocator, Order>& b)
+	{
+		return MatMul(EXECUTION::PAR_UNSEQ, a, b);
+	}
 
-		[[nodiscard]] uint32_t NCols() const
+	// b = a^T, for blocks of larger matrices; b must not overlap a
+	template<typename T, typename Policy>
+	void CopyTransposed(Policy policy, typename TypeIdentity<MatrixView<const T>>::Type a, typename TypeIdentity<MatrixView<T>>::Type b)
+	{
+		if (b.NRows() != a.NCols() || b.NCols() != a.NRows())
 		{
-			return m_ncols;
+			throw std::invalid_argument("CopyTransposed: the dimensions of the matrices do not match");
 		}
+		KERNELS::Transpose(policy, a.NRows(), a.NCols(), a.Data(), a.LeadingDimension(), b.Data(), b.LeadingDimension());
+	}
 
-	private:
+	template<typename T, typename Policy>
+	void CopyTransposed(Policy policy, typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<MatrixView<T, StorageOrder::COLUMN_MAJOR>>::Type b)
+	{
+		CopyTransposed<T>(policy, a.Transposed(), b.Transposed());
+	}
 
-		std::unique_ptr<T[]> m_data;
-		uint32_t m_nrows = 0;
-		uint32_t m_ncols = 0;
-	};
-}
\ No newline at end of file
+	template<typename T>
+	void CopyTransposed(typename TypeIdentity<MatrixView<const T>>::Type a, typename TypeIdentity<MatrixView<T>>::Type b)
+	{
+		CopyTransposed<T>(EXECUTION::PAR_UNSEQ, a, b);
+	}
+
+	template<typename T>
+	void CopyTransposed(typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<MatrixView<T, StorageOrder::COLUMN_MAJOR>>::Type b)
+	{
+		CopyTransposed<T>(EXECUTION::PAR_UNSEQ, a, b);
+	}
+
+	//==================================================================//
+	// Matrix-vector product: x and y are Vectors or views of them, so  //
+	// rows, columns and strided slices go in place. Large float and    //
+	// double products go to BLAS under PAR_UNSEQ, the others to the    //
+	// SIMD kernels of KERNELS::Gemv, row- or column-partitioned on the //
+	// worker threads.                                                  //
+	//==================================================================//
+
+	// y = alpha * op(a) * x + beta * y, with op(a) = a or its transpose; y must not overlap a or x
+	template<typename T, typename Policy>
+	void Gemv(Policy policy, Transpose transpose, T alpha, typename TypeIdentity<MatrixView<const T>>::Type a,
+			typename TypeIdentity<VectorView<const T>>::Type x, T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		const size_t m = a.NRows();
+		const size_t n = a.NCols();
+		const bool transposed = transpose == Transpose::YES;
+		if (x.Size() != (transposed ? m : n) || y.Size() != (transposed ? n : m))
+		{
+			throw std::invalid_argument("Gemv: the dimensions of the matrix and the vectors do not match");
+		}
+		if (KERNELS::UseBlas<T>(policy, m * n, KERNELS::BLAS_MIN_GEMV_SIZE, m, n, a.LeadingDimension(),
+				x.Stride(), y.Stride()))
+		{
+			KERNELS::BlasGemv<T>(transposed, m, n, alpha, a.Data(), a.LeadingDimension(),
+					x.Data(), x.Stride(), beta, y.Data(), y.Stride());
+			return;
+		}
+		KERNELS::Gemv<T>(policy, transpose, m, n, alpha, a.Data(), a.LeadingDimension(),
+				x.Data(), x.Stride(), beta, y.Data(), y.Stride());
+	}
+
+	// a column-major a is the row-major a^T, so the product runs with the other Transpose
+	template<typename T, typename Policy>
+	void Gemv(Policy policy, Transpose transpose, T alpha,
+			typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<VectorView<const T>>::Type x, T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		Gemv<T>(policy, transpose == Transpose::NO ? Transpose::YES : Transpose::NO, alpha, a.Transposed(), x, beta, y);
+	}
+
+	template<typename T>
+	void Gemv(Transpose transpose, T alpha, typename TypeIdentity<MatrixView<const T>>::Type a,
+			typename TypeIdentity<VectorView<const T>>::Type x, T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		Gemv<T>(EXECUTION::PAR_UNSEQ, transpose, alpha, a, x, beta, y);
+	}
+
+	template<typename T>
+	void Gemv(Transpose transpose, T alpha, typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<VectorView<const T>>::Type x, T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		Gemv<T>(EXECUTION::PAR_UNSEQ, transpose, alpha, a, x, beta, y);
+	}
+
+	// y = alpha * a * x + beta * y
+	template<typename T>
+	void Gemv(T alpha, typename TypeIdentity<MatrixView<const T>>::Type a, typename TypeIdentity<VectorView<const T>>::Type x,
+			T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		Gemv<T>(EXECUTION::PAR_UNSEQ, Transpose::NO, alpha, a, x, beta, y);
+	}
+
+	template<typename T>
+	void Gemv(T alpha, typename TypeIdentity<MatrixView<const T, StorageOrder::COLUMN_MAJOR>>::Type a,
+			typename TypeIdentity<VectorView<const T>>::Type x, T beta, typename TypeIdentity<VectorView<T>>::Type y)
+	{
+		Gemv<T>(EXECUTION::PAR_UNSEQ, Transpose::NO, alpha, a, x, beta, y);
+	}
+}
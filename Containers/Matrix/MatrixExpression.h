@@ -0,0 +1,461 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "../Expressions/Operations.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	// type of the matrix dimensions and of the row and column indices: 32-bit by default, which
+	// keeps the views and the expression nodes small, and 64-bit in the large-matrix mode, built
+	// with SEPOLIA4_LARGE_MATRICES. Element counts and offsets are size_t in both modes.
+#ifdef SEPOLIA4_LARGE_MATRICES
+	using MatrixIndex = uint64_t;
+#else
+	using MatrixIndex = uint32_t;
+#endif
+
+	// how the elements of a matrix are laid out in memory
+	enum class StorageOrder
+	{
+		ROW_MAJOR,      // element (i, j) at data[i * ld + j], as in C
+		COLUMN_MAJOR    // element (i, j) at data[j * ld + i], as in Fortran and LAPACK
+	};
+
+	// the order in which the transpose of a matrix has the same memory layout as the matrix
+	constexpr StorageOrder TransposedOrder(StorageOrder order)
+	{
+		return order == StorageOrder::ROW_MAJOR ? StorageOrder::COLUMN_MAJOR : StorageOrder::ROW_MAJOR;
+	}
+
+	template<typename T, typename Allocator, StorageOrder Order>
+	class Matrix;
+
+	//===================================================================//
+	// Base class of every matrix expression (CRTP).                     //
+	// The derived class provides ValueType, ORDER, NRows(), NCols(),    //
+	// the flat operator[] const, At(rowIdx, colIdx) and IsContiguous(): //
+	// whether all its operands store their rows (columns for            //
+	// COLUMN_MAJOR) back to back in the same ORDER, so that the flat    //
+	// operator[] is cheap and walks the elements in that order.         //
+	// Nothing is computed until the expression is assigned to a Matrix, //
+	// which then evaluates the whole tree in one pass over              //
+	// TotalElements() when the orders match, or line by line through    //
+	// At otherwise.                                                     //
+	//===================================================================//
+
+	template<typename E>
+	class MatrixExpression
+	{
+	public:
+
+		[[nodiscard]] const E& Derived() const
+		{
+			return static_cast<const E&>(*this);
+		}
+
+		[[nodiscard]] size_t TotalElements() const
+		{
+			return static_cast<size_t>(Derived().NRows()) * Derived().NCols();
+		}
+
+	protected:
+
+		MatrixExpression() = default;
+	};
+
+	//===================================================================//
+	// Containers are held by reference inside an expression tree, while //
+	// the (small) intermediate expression nodes are held by value.      //
+	//===================================================================//
+
+	template<typename E>
+	struct IsMatrixLeaf
+	{
+		static constexpr bool value = false;
+	};
+
+	template<typename T, typename Allocator, StorageOrder Order>
+	struct IsMatrixLeaf<Matrix<T, Allocator, Order>>
+	{
+		static constexpr bool value = true;
+	};
+
+	// other containers that are matrix expressions (TiledMatrix) specialize this one
+	template<typename E>
+	struct IsMatrixContainer
+	{
+		static constexpr bool value = IsMatrixLeaf<E>::value;
+	};
+
+	template<typename E>
+	using MatrixOperand = std::conditional_t<IsMatrixContainer<E>::value, const E&, const E>;
+
+	//========================//
+	// expression: lhs op rhs //
+	//========================//
+
+	template<typename L, typename R, typename Op>
+	class MatrixBinaryExpression final : public MatrixExpression<MatrixBinaryExpression<L, R, Op>>
+	{
+	public:
+
+		using ValueType = typename L::ValueType;
+
+		static constexpr StorageOrder ORDER = L::ORDER;
+
+		MatrixBinaryExpression(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs)
+		{
+		}
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_lhs.NRows();
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_lhs.NCols();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_lhs[idx], m_rhs[idx]);
+		}
+
+		[[nodiscard]] ValueType At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return Op::Apply(m_lhs.At(rowIdx, colIdx), m_rhs.At(rowIdx, colIdx));
+		}
+
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return L::ORDER == R::ORDER && m_lhs.IsContiguous() && m_rhs.IsContiguous();
+		}
+
+		[[nodiscard]] const L& Lhs() const
+		{
+			return m_lhs;
+		}
+
+		[[nodiscard]] const R& Rhs() const
+		{
+			return m_rhs;
+		}
+
+	private:
+
+		MatrixOperand<L> m_lhs;
+		MatrixOperand<R> m_rhs;
+	};
+
+	//===========================//
+	// expression: lhs op scalar //
+	//===========================//
+
+	template<typename E, typename Op>
+	class MatrixScalarExpression final : public MatrixExpression<MatrixScalarExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		static constexpr StorageOrder ORDER = E::ORDER;
+
+		MatrixScalarExpression(const E& lhs, ValueType val) : m_lhs(lhs), m_val(val)
+		{
+		}
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_lhs.NRows();
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_lhs.NCols();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_lhs[idx], m_val);
+		}
+
+		[[nodiscard]] ValueType At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return Op::Apply(m_lhs.At(rowIdx, colIdx), m_val);
+		}
+
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_lhs.IsContiguous();
+		}
+
+		[[nodiscard]] const E& Lhs() const
+		{
+			return m_lhs;
+		}
+
+		[[nodiscard]] ValueType Scalar() const
+		{
+			return m_val;
+		}
+
+	private:
+
+		MatrixOperand<E> m_lhs;
+		ValueType m_val;
+	};
+
+	//===========================//
+	// expression: scalar op rhs //
+	//===========================//
+
+	template<typename E, typename Op>
+	class ScalarMatrixExpression final : public MatrixExpression<ScalarMatrixExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		static constexpr StorageOrder ORDER = E::ORDER;
+
+		ScalarMatrixExpression(ValueType val, const E& rhs) : m_val(val), m_rhs(rhs)
+		{
+		}
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_rhs.NRows();
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_rhs.NCols();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_val, m_rhs[idx]);
+		}
+
+		[[nodiscard]] ValueType At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return Op::Apply(m_val, m_rhs.At(rowIdx, colIdx));
+		}
+
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_rhs.IsContiguous();
+		}
+
+		[[nodiscard]] ValueType Scalar() const
+		{
+			return m_val;
+		}
+
+		[[nodiscard]] const E& Rhs() const
+		{
+			return m_rhs;
+		}
+
+	private:
+
+		ValueType m_val;
+		MatrixOperand<E> m_rhs;
+	};
+
+	//=====================//
+	// expression: op expr //
+	//=====================//
+
+	template<typename E, typename Op>
+	class MatrixUnaryExpression final : public MatrixExpression<MatrixUnaryExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		static constexpr StorageOrder ORDER = E::ORDER;
+
+		explicit MatrixUnaryExpression(const E& expr) : m_expr(expr)
+		{
+		}
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_expr.NRows();
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_expr.NCols();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_expr[idx]);
+		}
+
+		[[nodiscard]] ValueType At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return Op::Apply(m_expr.At(rowIdx, colIdx));
+		}
+
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_expr.IsContiguous();
+		}
+
+	private:
+
+		MatrixOperand<E> m_expr;
+	};
+
+	//======================//
+	// arithmetic operators //
+	//======================//
+
+	template<typename L, typename R>
+	auto operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		return MatrixBinaryExpression<L, R, OPERATIONS::Plus>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator+(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		return MatrixScalarExpression<E, OPERATIONS::Plus>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator+(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return ScalarMatrixExpression<E, OPERATIONS::Plus>(val, rhs.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		return MatrixBinaryExpression<L, R, OPERATIONS::Minus>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator-(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		return MatrixScalarExpression<E, OPERATIONS::Minus>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator-(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return ScalarMatrixExpression<E, OPERATIONS::Minus>(val, rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator-(const MatrixExpression<E>& expr)
+	{
+		return MatrixUnaryExpression<E, OPERATIONS::Negate>(expr.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator*(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		return MatrixBinaryExpression<L, R, OPERATIONS::Multiplies>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator*(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		return MatrixScalarExpression<E, OPERATIONS::Multiplies>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator*(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return ScalarMatrixExpression<E, OPERATIONS::Multiplies>(val, rhs.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator/(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		return MatrixBinaryExpression<L, R, OPERATIONS::Divides>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator/(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		return MatrixScalarExpression<E, OPERATIONS::Divides>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator/(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return ScalarMatrixExpression<E, OPERATIONS::Divides>(val, rhs.Derived());
+	}
+
+	//================//
+	// Check equality //
+	//================//
+
+	template<typename L, typename R>
+	bool operator==(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		const auto& l = lhs.Derived();
+		const auto& r = rhs.Derived();
+		if (l.NRows() != r.NRows()) return false;
+		if (l.NCols() != r.NCols()) return false;
+		if (L::ORDER == R::ORDER && l.IsContiguous() && r.IsContiguous())
+		{
+			for (size_t i = 0; i < l.TotalElements(); i++)
+			{
+				if (l[i] != r[i]) return false;
+			}
+			return true;
+		}
+		for (MatrixIndex i = 0; i < l.NRows(); i++)
+		{
+			for (MatrixIndex j = 0; j < l.NCols(); j++)
+			{
+				if (l.At(i, j) != r.At(i, j)) return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename E>
+	bool operator==(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		const auto& l = lhs.Derived();
+		for (size_t i = 0; i < l.TotalElements(); i++)
+		{
+			if (l[i] != val) return false;
+		}
+		return true;
+	}
+
+	template<typename E>
+	bool operator==(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return rhs == val;
+	}
+
+	template<typename L, typename R>
+	bool operator!=(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<typename E>
+	bool operator!=(const MatrixExpression<E>& lhs, typename E::ValueType val)
+	{
+		return !(lhs == val);
+	}
+
+	template<typename E>
+	bool operator!=(typename E::ValueType val, const MatrixExpression<E>& rhs)
+	{
+		return !(rhs == val);
+	}
+}
@@ -0,0 +1,639 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "MatrixExpression.h"
+#include "../Vector/VectorView.h"
+#include "../Kernels/SimdKernels.h"
+#include "../Kernels/ReductionKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	template<typename T, StorageOrder Order = StorageOrder::ROW_MAJOR>
+	class MatrixView;
+
+	template<typename E>
+	struct IsMatrixView
+	{
+		static constexpr bool value = false;
+	};
+
+	template<typename T, StorageOrder Order>
+	struct IsMatrixView<MatrixView<T, Order>>
+	{
+		static constexpr bool value = true;
+	};
+
+	// T in a parameter that takes no part in template argument deduction, so that arguments convert to it
+	template<typename T>
+	struct TypeIdentity
+	{
+		using Type = T;
+	};
+
+	//===================================================================//
+	// Non-owning view of a block: element (i, j) lives at               //
+	// data[i * ld + j] in a ROW_MAJOR view and at data[j * ld + i] in a //
+	// COLUMN_MAJOR one, with the leading dimension ld >= ncols (nrows)  //
+	// as in BLAS and LAPACK, so a block of a larger matrix is viewed in //
+	// place and can be handed to cblas_* or LAPACK as                   //
+	// (Data(), LeadingDimension()). A view is a matrix expression, so   //
+	// every Matrix operation accepts it, and it has the in-place        //
+	// operations and the reductions of Matrix.                          //
+	// MatrixView<const T> is read-only. Copying a view copies the       //
+	// reference; assigning to a view writes its elements, and the       //
+	// dimensions must then match.                                       //
+	//===================================================================//
+
+	template<typename T, StorageOrder Order>
+	class MatrixView final : public MatrixExpression<MatrixView<T, Order>>
+	{
+	public:
+
+		using ValueType = std::remove_const_t<T>;
+
+		static constexpr StorageOrder ORDER = Order;
+
+		//==============//
+		// Constructors //
+		//==============//
+
+		MatrixView() = default;
+
+		MatrixView(T* data, MatrixIndex nrows, MatrixIndex ncols) :
+				MatrixView(data, nrows, ncols, Order == StorageOrder::ROW_MAJOR ? ncols : nrows)
+		{
+		}
+
+		MatrixView(T* data, MatrixIndex nrows, MatrixIndex ncols, size_t ld) : m_data(data), m_nrows(nrows), m_ncols(ncols), m_ld(ld)
+		{
+		}
+
+		template<typename A>
+		MatrixView(Matrix<ValueType, A, Order>& mat) : MatrixView(mat.Data(), mat.NRows(), mat.NCols(), mat.LeadingDimension())
+		{
+		}
+
+		template<typename A, typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+		MatrixView(const Matrix<ValueType, A, Order>& mat) : MatrixView(mat.Data(), mat.NRows(), mat.NCols(), mat.LeadingDimension())
+		{
+		}
+
+		// a writable view converts to a read-only one
+		template<typename U, std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>, int> = 0>
+		MatrixView(const MatrixView<U, Order>& other) : MatrixView(other.Data(), other.NRows(), other.NCols(), other.LeadingDimension())
+		{
+		}
+
+		MatrixView(const MatrixView& other) = default;
+
+		MatrixView& operator=(const MatrixView& other)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, other);
+		}
+
+		template<typename E>
+		MatrixView& operator=(const MatrixExpression<E>& expr)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, expr);
+		}
+
+		//======================//
+		// Geometry of the view //
+		//======================//
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_nrows;
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_ncols;
+		}
+
+		// distance, in elements, between the starts of consecutive rows (columns for COLUMN_MAJOR)
+		[[nodiscard]] size_t LeadingDimension() const
+		{
+			return m_ld;
+		}
+
+		// true when the rows (columns) follow each other without gaps
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_ld == LineLength() || Lines() <= 1;
+		}
+
+		[[nodiscard]] T* Data() const
+		{
+			return m_data;
+		}
+
+		// view of the nrows x ncols block whose top left element is (rowIdx, colIdx)
+		[[nodiscard]] MatrixView Block(MatrixIndex rowIdx, MatrixIndex colIdx, MatrixIndex nrows, MatrixIndex ncols) const
+		{
+			return MatrixView(m_data + Offset(rowIdx, colIdx), nrows, ncols, m_ld);
+		}
+
+		// the same elements seen as the transpose, which has this layout in the other order
+		[[nodiscard]] MatrixView<T, TransposedOrder(Order)> Transposed() const
+		{
+			return MatrixView<T, TransposedOrder(Order)>(m_data, m_ncols, m_nrows, m_ld);
+		}
+
+		[[nodiscard]] VectorView<T> Row(MatrixIndex rowIdx) const
+		{
+			return VectorView<T>(m_data + Offset(rowIdx, 0), m_ncols, Order == StorageOrder::ROW_MAJOR ? size_t(1) : m_ld);
+		}
+
+		[[nodiscard]] VectorView<T> Col(MatrixIndex colIdx) const
+		{
+			return VectorView<T>(m_data + Offset(0, colIdx), m_nrows, Order == StorageOrder::ROW_MAJOR ? m_ld : size_t(1));
+		}
+
+		[[nodiscard]] VectorView<T> Diagonal() const
+		{
+			return VectorView<T>(m_data, std::min(m_nrows, m_ncols), m_ld + 1);
+		}
+
+		//======================================//
+		// Operators to access and set elements //
+		//======================================//
+
+		[[nodiscard]] const ValueType& At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return m_data[Offset(rowIdx, colIdx)];
+		}
+
+		T& operator()(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return m_data[Offset(rowIdx, colIdx)];
+		}
+
+		// element idx in the storage order
+		T& operator[](size_t idx) const
+		{
+			if (IsContiguous()) return m_data[idx];
+			return m_data[idx / LineLength() * m_ld + idx % LineLength()];
+		}
+
+		//================================================================//
+		// Reductions over all the elements. Without a policy argument    //
+		// they use PAR_UNSEQ. Min, Max and MinMax need a non-empty view. //
+		// Views with gaps between the rows (columns) are reduced row by  //
+		// row (column by column), then the partial results are combined. //
+		//================================================================//
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Sum(Policy policy, Summation summation = Summation::FAST) const
+		{
+			if (IsContiguous()) return KERNELS::SumAll(policy, m_data, this->TotalElements(), summation);
+			const auto partials = LinePartials<ValueType>(policy, [policy, summation, n = LineLength()](const ValueType* line)
+			{
+				return KERNELS::Sum(policy, line, n, summation);
+			});
+			return KERNELS::Sum(policy, partials.data(), partials.size(), summation);
+		}
+
+		[[nodiscard]] ValueType Sum(Summation summation = Summation::FAST) const
+		{
+			return Sum(EXECUTION::PAR_UNSEQ, summation);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType FrobeniusNorm(Policy policy) const
+		{
+			if (IsContiguous()) return static_cast<ValueType>(std::sqrt(KERNELS::DotAll(policy, m_data, m_data, this->TotalElements())));
+			const auto partials = LinePartials<ValueType>(policy, [policy, n = LineLength()](const ValueType* line)
+			{
+				return KERNELS::Dot(policy, line, line, n);
+			});
+			return static_cast<ValueType>(std::sqrt(KERNELS::Reduce<OPERATIONS::Plus>(policy, partials.data(), partials.size(), ValueType(0))));
+		}
+
+		[[nodiscard]] ValueType FrobeniusNorm() const
+		{
+			return FrobeniusNorm(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Min(Policy policy) const
+		{
+			return ReduceElements<OPERATIONS::Min>(policy);
+		}
+
+		[[nodiscard]] ValueType Min() const
+		{
+			return Min(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Max(Policy policy) const
+		{
+			return ReduceElements<OPERATIONS::Max>(policy);
+		}
+
+		[[nodiscard]] ValueType Max() const
+		{
+			return Max(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] std::pair<ValueType, ValueType> MinMax(Policy policy) const
+		{
+			if (IsContiguous()) return KERNELS::MinMaxAll(policy, m_data, this->TotalElements());
+			const auto partials = LinePartials<std::pair<ValueType, ValueType>>(policy, [policy, n = LineLength()](const ValueType* line)
+			{
+				return KERNELS::MinMax(policy, line, n);
+			});
+			auto res = partials[0];
+			for (size_t k = 1; k < partials.size(); k++)
+			{
+				res.first = OPERATIONS::Min::Apply(res.first, partials[k].first);
+				res.second = OPERATIONS::Max::Apply(res.second, partials[k].second);
+			}
+			return res;
+		}
+
+		[[nodiscard]] std::pair<ValueType, ValueType> MinMax() const
+		{
+			return MinMax(EXECUTION::PAR_UNSEQ);
+		}
+
+		//=================================================================//
+		// Operations with an execution policy, as for Matrix. The right   //
+		// hand side may refer to the viewed elements only index by index: //
+		// it must not read other elements of an overlapping view.         //
+		//=================================================================//
+
+		template<typename Policy, typename E>
+		MatrixView& Assign(Policy policy, const MatrixExpression<E>& expr)
+		{
+			Evaluate(policy, expr.Derived());
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		MatrixView& Add(Policy policy, const MatrixExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Plus>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		MatrixView& Add(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Plus>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		MatrixView& Subtract(Policy policy, const MatrixExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Minus>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		MatrixView& Subtract(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Minus>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		MatrixView& Multiply(Policy policy, const MatrixExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Multiplies>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		MatrixView& Multiply(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Multiplies>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		MatrixView& Divide(Policy policy, const MatrixExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Divides>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		MatrixView& Divide(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Divides>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy>
+		MatrixView& Fill(Policy policy, ValueType val)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [view, val](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					std::fill_n(view.m_data + i * view.m_ld, view.LineLength(), val);
+				}
+			});
+			return *this;
+		}
+
+		//===============================//
+		// Compound assignment operators //
+		//===============================//
+
+		template<typename E>
+		MatrixView& operator+=(const MatrixExpression<E>& rhs)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		MatrixView& operator+=(ValueType val)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		MatrixView& operator-=(const MatrixExpression<E>& rhs)
+		{
+			return Subtract(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		MatrixView& operator-=(ValueType val)
+		{
+			return Subtract(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		MatrixView& operator*=(const MatrixExpression<E>& rhs)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		MatrixView& operator*=(ValueType val)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		MatrixView& operator/=(const MatrixExpression<E>& rhs)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		MatrixView& operator/=(ValueType val)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		//============================//
+		// Assignment value operators //
+		//============================//
+
+		MatrixView& operator=(ValueType val)
+		{
+			return Fill(EXECUTION::PAR_UNSEQ, val);
+		}
+
+	private:
+
+		template<typename U, StorageOrder>
+		friend class MatrixView;
+
+		// the rows of a ROW_MAJOR view and the columns of a COLUMN_MAJOR one: the runs stored back to back
+
+		[[nodiscard]] MatrixIndex Lines() const
+		{
+			return Order == StorageOrder::ROW_MAJOR ? m_nrows : m_ncols;
+		}
+
+		[[nodiscard]] MatrixIndex LineLength() const
+		{
+			return Order == StorageOrder::ROW_MAJOR ? m_ncols : m_nrows;
+		}
+
+		[[nodiscard]] size_t Offset(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			if constexpr (Order == StorageOrder::ROW_MAJOR) return rowIdx * m_ld + colIdx;
+			else return colIdx * m_ld + rowIdx;
+		}
+
+		// element k of line i of an expression of the same dimensions
+		template<typename E>
+		static auto LineElement(const E& e, MatrixIndex i, MatrixIndex k)
+		{
+			if constexpr (Order == StorageOrder::ROW_MAJOR) return e.At(i, k);
+			else return e.At(k, i);
+		}
+
+		// lineReduce(line) on every line, the lines in chunks on the worker threads under parallel policies
+		template<typename R, typename Policy, typename F>
+		std::vector<R> LinePartials(Policy policy, F&& lineReduce) const
+		{
+			std::vector<R> partials(Lines());
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [view, &partials, &lineReduce](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					partials[i] = lineReduce(view.m_data + i * view.m_ld);
+				}
+			});
+			return partials;
+		}
+
+		template<typename Op, typename Policy>
+		ValueType ReduceElements(Policy policy) const
+		{
+			if (IsContiguous()) return KERNELS::ReduceAll<Op>(policy, m_data, this->TotalElements());
+			const auto partials = LinePartials<ValueType>(policy, [policy, n = LineLength()](const ValueType* line)
+			{
+				return KERNELS::Reduce<Op>(policy, line + 1, n - 1, line[0]);
+			});
+			return KERNELS::Reduce<Op>(policy, partials.data() + 1, partials.size() - 1, partials[0]);
+		}
+
+		// elements and leading dimension of a matrix or view operand in the same order, nullptr for anything else
+		template<typename E>
+		static std::pair<const ValueType*, size_t> LeafData(const E& e)
+		{
+			if constexpr (!std::is_same_v<typename E::ValueType, ValueType> || E::ORDER != Order) return { nullptr, 0 };
+			else if constexpr (IsMatrixLeaf<E>::value) return { e.Data(), e.LeadingDimension() };
+			else if constexpr (IsMatrixView<E>::value) return { e.Data(), e.LeadingDimension() };
+			else return { nullptr, 0 };
+		}
+
+		//========================================//
+		// Fused evaluation of an expression tree //
+		//========================================//
+
+		template<typename Policy, typename E>
+		void Evaluate(Policy policy, const E& e)
+		{
+			EvaluateElements(policy, e);
+		}
+
+		// flat when both sides are contiguous in the same order, line by line through At otherwise
+		template<typename Policy, typename E>
+		void EvaluateElements(Policy policy, const E& e)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			const MatrixView view = *this;
+			if (E::ORDER == Order && IsContiguous() && e.IsContiguous())
+			{
+				KERNELS::ForChunks<ValueType>(policy, this->TotalElements(), [view, &e](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						view.m_data[i] = e[i];
+					}
+				});
+				return;
+			}
+
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [view, &e](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					T* const line = view.m_data + i * view.m_ld;
+					for (MatrixIndex k = 0; k < view.LineLength(); k++)
+					{
+						line[k] = LineElement(e, static_cast<MatrixIndex>(i), k);
+					}
+				}
+			});
+		}
+
+		// single operations on matrices and views of the same order go to the SIMD kernels line by line
+
+		template<typename Policy, typename L, typename R, typename Op>
+		void Evaluate(Policy policy, const MatrixBinaryExpression<L, R, Op>& e)
+		{
+			const auto [a, lda] = LeafData(e.Lhs());
+			const auto [b, ldb] = LeafData(e.Rhs());
+			if (!a || !b)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [policy, view, a = a, lda = lda, b = b, ldb = ldb](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					KERNELS::Binary<Op>(policy, a + i * lda, b + i * ldb, view.m_data + i * view.m_ld, view.LineLength());
+				}
+			});
+		}
+
+		template<typename Policy, typename E, typename Op>
+		void Evaluate(Policy policy, const MatrixScalarExpression<E, Op>& e)
+		{
+			const auto [a, lda] = LeafData(e.Lhs());
+			if (!a)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			const ValueType val = e.Scalar();
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [policy, view, a = a, lda = lda, val](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					KERNELS::Binary<Op>(policy, a + i * lda, val, view.m_data + i * view.m_ld, view.LineLength());
+				}
+			});
+		}
+
+		template<typename Policy, typename E, typename Op>
+		void Evaluate(Policy policy, const ScalarMatrixExpression<E, Op>& e)
+		{
+			const auto [b, ldb] = LeafData(e.Rhs());
+			if (!b)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			const ValueType val = e.Scalar();
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [policy, view, val, b = b, ldb = ldb](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					KERNELS::Binary<Op>(policy, val, b + i * ldb, view.m_data + i * view.m_ld, view.LineLength());
+				}
+			});
+		}
+
+		//======================================//
+		// In-place compound assignment kernels //
+		//======================================//
+
+		template<typename Op, typename Policy, typename E>
+		void CompoundAssign(Policy policy, const E& e)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			const MatrixView view = *this;
+			const auto [b, ldb] = LeafData(e);
+			if (b)
+			{
+				KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [policy, view, b = b, ldb = ldb](size_t beginLine, size_t endLine)
+				{
+					for (size_t i = beginLine; i < endLine; i++)
+					{
+						T* const line = view.m_data + i * view.m_ld;
+						KERNELS::Binary<Op>(policy, line, b + i * ldb, line, view.LineLength());
+					}
+				});
+				return;
+			}
+
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [view, &e](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					T* const line = view.m_data + i * view.m_ld;
+					for (MatrixIndex k = 0; k < view.LineLength(); k++)
+					{
+						line[k] = Op::Apply(line[k], LineElement(e, static_cast<MatrixIndex>(i), k));
+					}
+				}
+			});
+		}
+
+		template<typename Op, typename Policy>
+		void CompoundAssignScalar(Policy policy, ValueType val)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			const MatrixView view = *this;
+			KERNELS::ForRows<ValueType>(policy, Lines(), LineLength(), [policy, view, val](size_t beginLine, size_t endLine)
+			{
+				for (size_t i = beginLine; i < endLine; i++)
+				{
+					T* const line = view.m_data + i * view.m_ld;
+					KERNELS::Binary<Op>(policy, line, val, line, view.LineLength());
+				}
+			});
+		}
+
+		T* m_data = nullptr;
+		MatrixIndex m_nrows = 0;
+		MatrixIndex m_ncols = 0;
+		size_t m_ld = 0;
+	};
+}
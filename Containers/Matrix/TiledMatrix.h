@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.h"
+#include "MatrixExpression.h"
+#include "MatrixView.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../Kernels/TileKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	//===================================================================//
+	// Matrix in tile-contiguous storage: TILE x TILE row-major tiles    //
+	// stored back to back (see KERNELS::PackTiles), so that a block of  //
+	// work, a stencil neighbourhood or a panel of a blocked             //
+	// factorization, sits in a few consecutive pages that fit L1 or L2  //
+	// and is prefetched linearly, in both directions. Tile(ti, tj) is a //
+	// MatrixView of one tile (ld = TILE), with all the operations of    //
+	// views, Gemm included. Conversions from and to row-major matrices  //
+	// and views go through the packing kernels; the matrix is also a    //
+	// matrix expression, read element by element through At.            //
+	// With the default allocator every tile starts on a cache line.     //
+	//===================================================================//
+
+	template<typename T, size_t TILE = 32, typename Allocator = AlignedAllocator<T>>
+	class TiledMatrix final : public MatrixExpression<TiledMatrix<T, TILE, Allocator>>
+	{
+		static_assert(TILE > 0 && (TILE & (TILE - 1)) == 0, "TILE must be a power of two");
+
+	public:
+
+		using ValueType = T;
+		using AllocatorType = Allocator;
+
+		static constexpr StorageOrder ORDER = StorageOrder::ROW_MAJOR;
+
+		static constexpr size_t TILE_SIZE = TILE;
+
+		//==============//
+		// Constructors //
+		//==============//
+
+		TiledMatrix() = default;
+
+		TiledMatrix(MatrixIndex nrows, MatrixIndex ncols, const Allocator& allocator = Allocator()) :
+				m_data(KERNELS::TileCount<TILE>(nrows) * KERNELS::TileCount<TILE>(ncols) * TILE * TILE, allocator),
+				m_nrows(nrows), m_ncols(ncols)
+		{
+		}
+
+		explicit TiledMatrix(MatrixView<const T> a, const Allocator& allocator = Allocator()) :
+				TiledMatrix(a.NRows(), a.NCols(), allocator)
+		{
+			KERNELS::PackTiles<TILE>(EXECUTION::PAR_UNSEQ, m_nrows, m_ncols, a.Data(), a.LeadingDimension(), m_data.data());
+		}
+
+		//========================================================//
+		// Conversions from and to row-major matrices and views.  //
+		// Without a policy argument they use PAR_UNSEQ. Assign   //
+		// takes the dimensions of a, CopyTo needs matching ones. //
+		//========================================================//
+
+		template<typename Policy>
+		TiledMatrix& Assign(Policy policy, MatrixView<const T> a)
+		{
+			if (a.NRows() != m_nrows || a.NCols() != m_ncols)
+			{
+				*this = TiledMatrix(a.NRows(), a.NCols(), m_data.get_allocator());
+			}
+			KERNELS::PackTiles<TILE>(policy, m_nrows, m_ncols, a.Data(), a.LeadingDimension(), m_data.data());
+			return *this;
+		}
+
+		TiledMatrix& Assign(MatrixView<const T> a)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, a);
+		}
+
+		template<typename Policy>
+		void CopyTo(Policy policy, MatrixView<T> b) const
+		{
+			if (b.NRows() != m_nrows || b.NCols() != m_ncols)
+			{
+				throw std::invalid_argument("CopyTo: the dimensions of the matrices do not match");
+			}
+			KERNELS::UnpackTiles<TILE>(policy, m_nrows, m_ncols, m_data.data(), b.Data(), b.LeadingDimension());
+		}
+
+		void CopyTo(MatrixView<T> b) const
+		{
+			CopyTo(EXECUTION::PAR_UNSEQ, b);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] Matrix<T, Allocator> ToMatrix(Policy policy) const
+		{
+			Matrix<T, Allocator> res(m_nrows, m_ncols, UNINITIALIZED, m_data.get_allocator());
+			CopyTo(policy, res);
+			return res;
+		}
+
+		[[nodiscard]] Matrix<T, Allocator> ToMatrix() const
+		{
+			return ToMatrix(EXECUTION::PAR_UNSEQ);
+		}
+
+		//======================================//
+		// Operators to access and set elements //
+		//======================================//
+
+		[[nodiscard]] const T& At(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return m_data[Offset(rowIdx, colIdx)];
+		}
+
+		T& operator()(MatrixIndex rowIdx, MatrixIndex colIdx)
+		{
+			return m_data[Offset(rowIdx, colIdx)];
+		}
+
+		// element idx in row-major order
+		T operator[](size_t idx) const
+		{
+			return At(static_cast<MatrixIndex>(idx / m_ncols), static_cast<MatrixIndex>(idx % m_ncols));
+		}
+
+		// view of the tile in tile row ti and tile column tj; the tiles on the edges may be smaller
+		[[nodiscard]] MatrixView<T> Tile(MatrixIndex ti, MatrixIndex tj)
+		{
+			return MatrixView<T>(m_data.data() + TileOffset(ti, tj), TileExtent(m_nrows, ti), TileExtent(m_ncols, tj), TILE);
+		}
+
+		[[nodiscard]] MatrixView<const T> Tile(MatrixIndex ti, MatrixIndex tj) const
+		{
+			return MatrixView<const T>(m_data.data() + TileOffset(ti, tj), TileExtent(m_nrows, ti), TileExtent(m_ncols, tj), TILE);
+		}
+
+		template<typename Policy>
+		TiledMatrix& Fill(Policy policy, T val)
+		{
+			T* const data = m_data.data();
+			KERNELS::ForChunks<T>(policy, m_data.size(), [data, val](size_t begin, size_t end)
+			{
+				std::fill(data + begin, data + end, val);
+			});
+			return *this;
+		}
+
+		TiledMatrix& operator=(T val)
+		{
+			return Fill(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		[[nodiscard]] MatrixIndex NRows() const
+		{
+			return m_nrows;
+		}
+
+		[[nodiscard]] MatrixIndex NCols() const
+		{
+			return m_ncols;
+		}
+
+		[[nodiscard]] MatrixIndex TileRows() const
+		{
+			return static_cast<MatrixIndex>(KERNELS::TileCount<TILE>(m_nrows));
+		}
+
+		[[nodiscard]] MatrixIndex TileCols() const
+		{
+			return static_cast<MatrixIndex>(KERNELS::TileCount<TILE>(m_ncols));
+		}
+
+		// the flat operator[] is not the storage order
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return false;
+		}
+
+		[[nodiscard]] T* Data()
+		{
+			return m_data.data();
+		}
+
+		[[nodiscard]] const T* Data() const
+		{
+			return m_data.data();
+		}
+
+		// elements in storage, the padding of the edge tiles included
+		[[nodiscard]] size_t StorageSize() const
+		{
+			return m_data.size();
+		}
+
+	private:
+
+		[[nodiscard]] size_t TileOffset(MatrixIndex ti, MatrixIndex tj) const
+		{
+			return (ti * KERNELS::TileCount<TILE>(m_ncols) + tj) * TILE * TILE;
+		}
+
+		[[nodiscard]] size_t Offset(MatrixIndex rowIdx, MatrixIndex colIdx) const
+		{
+			return TileOffset(rowIdx / TILE, colIdx / TILE) + (rowIdx % TILE) * TILE + colIdx % TILE;
+		}
+
+		static MatrixIndex TileExtent(MatrixIndex n, MatrixIndex tileIdx)
+		{
+			return static_cast<MatrixIndex>(std::min<size_t>(TILE, n - static_cast<size_t>(tileIdx) * TILE));
+		}
+
+		std::vector<T, Allocator> m_data;
+		MatrixIndex m_nrows = 0;
+		MatrixIndex m_ncols = 0;
+	};
+
+	template<typename T, size_t TILE, typename Allocator>
+	struct IsMatrixContainer<TiledMatrix<T, TILE, Allocator>>
+	{
+		static constexpr bool value = true;
+	};
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace SEPOLIA4::CONTAINERS
+{
+	//===================================================================//
+	// Standard-conforming allocator returning ALIGNMENT-byte aligned    //
+	// storage. The default (64 bytes) matches a cache line and an       //
+	// AVX-512 register, so the containers' buffers never straddle a     //
+	// cache line at their start and aligned SIMD loads are always legal //
+	//                                                                   //
+	// On Linux, blocks of at least MMAP_THRESHOLD bytes are mapped      //
+	// directly, so that reallocate() can grow them with mremap instead  //
+	// of copying them.                                                  //
+	//===================================================================//
+
+	constexpr size_t CACHE_LINE_SIZE = 64;
+
+	constexpr size_t MEMORY_PAGE_SIZE = 4096;
+
+	template<typename T, size_t ALIGNMENT = CACHE_LINE_SIZE>
+	class AlignedAllocator
+	{
+		static_assert(ALIGNMENT >= alignof(T), "ALIGNMENT must not be weaker than the alignment of T");
+		static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "ALIGNMENT must be a power of two");
+
+	public:
+
+		using value_type = T;
+
+		template<typename U>
+		struct rebind
+		{
+			using other = AlignedAllocator<U, ALIGNMENT>;
+		};
+
+		AlignedAllocator() noexcept = default;
+
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>&) noexcept
+		{
+		}
+
+		static constexpr size_t MMAP_THRESHOLD = size_t(1) << 21;
+
+		[[nodiscard]] T* allocate(size_t n)
+		{
+			if (n > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+			const size_t bytes = n * sizeof(T);
+#ifdef __linux__
+			if (IsMapped(bytes))
+			{
+				void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (ptr == MAP_FAILED) throw std::bad_alloc();
+				return static_cast<T*>(ptr);
+			}
+#endif
+			return static_cast<T*>(::operator new(bytes, std::align_val_t{ ALIGNMENT }));
+		}
+
+		void deallocate(T* ptr, size_t n) noexcept
+		{
+#ifdef __linux__
+			if (IsMapped(n * sizeof(T)))
+			{
+				munmap(ptr, n * sizeof(T));
+				return;
+			}
+#endif
+			::operator delete(ptr, std::align_val_t{ ALIGNMENT });
+		}
+
+		// resizes a block keeping its first min(oldN, newN) elements byte by byte:
+		// callers use it for trivially copyable types only
+		[[nodiscard]] T* reallocate(T* ptr, size_t oldN, size_t newN)
+		{
+#ifdef __linux__
+			if (IsMapped(oldN * sizeof(T)) && IsMapped(newN * sizeof(T)))
+			{
+				void* newPtr = mremap(ptr, oldN * sizeof(T), newN * sizeof(T), MREMAP_MAYMOVE);
+				if (newPtr == MAP_FAILED) throw std::bad_alloc();
+				return static_cast<T*>(newPtr);
+			}
+#endif
+			T* newPtr = allocate(newN);
+			std::memcpy(static_cast<void*>(newPtr), ptr, std::min(oldN, newN) * sizeof(T));
+			deallocate(ptr, oldN);
+			return newPtr;
+		}
+
+		template<typename U>
+		bool operator==(const AlignedAllocator<U, ALIGNMENT>&) const noexcept
+		{
+			return true;
+		}
+
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U, ALIGNMENT>&) const noexcept
+		{
+			return false;
+		}
+
+	private:
+
+		static constexpr bool IsMapped(size_t bytes)
+		{
+			return ALIGNMENT <= MEMORY_PAGE_SIZE && bytes >= MMAP_THRESHOLD;
+		}
+	};
+
+	//================================================================//
+	// Allocators may provide reallocate(ptr, oldN, newN) to resize a //
+	// block of trivially copyable elements without a separate copy   //
+	//================================================================//
+
+	template<typename Allocator, typename = void>
+	struct HasReallocate : std::false_type
+	{
+	};
+
+	template<typename Allocator>
+	struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+			std::declval<typename Allocator::value_type*>(), size_t(), size_t()))>> : std::true_type
+	{
+	};
+
+	//=================================================================//
+	// Alignment guaranteed by an allocator: containers use it to keep //
+	// the same guarantee for storage they do not get from it          //
+	//=================================================================//
+
+	template<typename Allocator>
+	struct AllocatorAlignment
+	{
+		static constexpr size_t value = alignof(std::max_align_t);
+	};
+
+	template<typename T, size_t ALIGNMENT>
+	struct AllocatorAlignment<AlignedAllocator<T, ALIGNMENT>>
+	{
+		static constexpr size_t value = ALIGNMENT;
+	};
+}
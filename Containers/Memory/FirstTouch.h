@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include "../Kernels/ParallelKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	//==================================================================//
+	// Tag selecting the allocation mode where the elements are        //
+	// initialized by all the worker threads, each on its own chunk.   //
+	// On NUMA machines the first write places a page on the node of   //
+	// the writing thread, so the pages end up next to the threads of  //
+	// the later parallel kernels, which use the same partition.       //
+	//==================================================================//
+
+	struct ParallelFirstTouchTag
+	{
+		explicit ParallelFirstTouchTag() = default;
+	};
+
+	inline constexpr ParallelFirstTouchTag PARALLEL_FIRST_TOUCH{};
+
+	template<typename Allocator, typename T>
+	void ParallelFirstTouch(Allocator& allocator, T* data, size_t n)
+	{
+		KERNELS::ParallelChunks<T>(n, [&allocator, data](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				std::allocator_traits<Allocator>::construct(allocator, data + i);
+			}
+		});
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include "AlignedAllocator.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	//===================================================================//
+	// Tag selecting the constructors of matrices whose rows (columns)   //
+	// are padded to PaddedLeadingDimension: with the cache-line aligned //
+	// storage of AlignedAllocator every row starts on a cache line, and //
+	// the stride between rows is an odd number of cache lines, so a     //
+	// walk down a column visits every cache set instead of hammering a  //
+	// few of them, as power-of-two row lengths (1024, 4096, ...) do.    //
+	//===================================================================//
+
+	struct PaddedTag
+	{
+		explicit PaddedTag() = default;
+	};
+
+	inline constexpr PaddedTag PADDED{};
+
+	// n rounded up to a whole, odd number of cache lines; types that do not tile a cache line are not padded
+	template<typename T>
+	constexpr size_t PaddedLeadingDimension(size_t n)
+	{
+		if (n == 0 || CACHE_LINE_SIZE % sizeof(T) != 0) return n;
+		constexpr size_t LINE_ELEMENTS = CACHE_LINE_SIZE / sizeof(T);
+		size_t lines = (n + LINE_ELEMENTS - 1) / LINE_ELEMENTS;
+		if (lines % 2 == 0) lines++;
+		return lines * LINE_ELEMENTS;
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace SEPOLIA4::CONTAINERS
+{
+	//=====================================================================//
+	// Tag selecting the constructors that leave the elements of trivial  //
+	// types uninitialized, for buffers that are about to be overwritten //
+	//=====================================================================//
+
+	struct UninitializedTag
+	{
+		explicit UninitializedTag() = default;
+	};
+
+	inline constexpr UninitializedTag UNINITIALIZED{};
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "../Matrix/Matrix.h"
+#include "../Vector/Vector.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../../Utilities/Checksum.h"
+#include "../../Utilities/MappedFile.h"
+
+namespace SEPOLIA4::CONTAINERS::SERIALIZATION
+{
+	//===================================================================//
+	// Binary files of vectors and matrices: a 64-byte FileHeader (type, //
+	// shape, storage order, checksum), padding up to dataOffset, then   //
+	// the elements as they are in memory, rows (columns) back to back,  //
+	// without the padding of padded matrices. dataOffset is a multiple  //
+	// of DATA_ALIGNMENT, so that in a mapped file the elements start on //
+	// a cache line, as in storage from AlignedAllocator: MapMatrix and  //
+	// MapVector return containers on the mapping, with no parsing and   //
+	// no copy, paged in as they are used. The mappings are private      //
+	// (COPY_ON_WRITE) by default, so that writes to the containers      //
+	// never reach the file. Load* read the elements into allocated      //
+	// storage and always verify the checksum; Map* verify it only on    //
+	// request, since it reads every page. Files are written in the byte //
+	// order of the machine and rejected by machines of the other order. //
+	// Malformed, truncated or corrupted files, and files of another     //
+	// type or shape, throw std::runtime_error.                          //
+	//===================================================================//
+
+	enum class DataType : uint8_t
+	{
+		INT8 = 1,
+		UINT8 = 2,
+		INT16 = 3,
+		UINT16 = 4,
+		INT32 = 5,
+		UINT32 = 6,
+		INT64 = 7,
+		UINT64 = 8,
+		FLOAT32 = 9,
+		FLOAT64 = 10
+	};
+
+	struct FileHeader
+	{
+		char magic[8];          // MAGIC
+		uint32_t version;       // VERSION of the writer
+		uint32_t byteOrderMark; // BYTE_ORDER_MARK in the byte order of the writer
+		uint8_t dataType;       // DataType of the elements
+		uint8_t elementSize;    // bytes per element
+		uint8_t rank;           // 1 for vectors, 2 for matrices
+		uint8_t storageOrder;   // StorageOrder of matrices, ROW_MAJOR for vectors
+		uint32_t reserved;      // zero
+		uint64_t shape[2];      // rows and columns of matrices, size and 1 of vectors
+		uint64_t dataOffset;    // bytes from the start of the file to the first element
+		uint64_t dataBytes;     // bytes of elements
+		uint64_t checksum;      // UTILITIES::Checksum64 of the elements
+	};
+
+	static_assert(sizeof(FileHeader) == 64 && std::is_trivially_copyable_v<FileHeader>);
+
+	inline constexpr char MAGIC[8] = { 'S', 'E', 'P', '4', 'B', 'I', 'N', '\0' };
+
+	constexpr uint32_t VERSION = 1;
+
+	constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+	constexpr size_t DATA_ALIGNMENT = CACHE_LINE_SIZE;
+
+	// elements are read and written in chunks that stay in the L2 cache between the I/O and the checksum
+	constexpr size_t IO_CHUNK_BYTES = size_t(1) << 20;
+
+	template<typename T>
+	constexpr DataType DataTypeOf()
+	{
+		static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+				"only integer and floating-point elements can be serialized");
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only float and double are serialized");
+			return sizeof(T) == 4 ? DataType::FLOAT32 : DataType::FLOAT64;
+		}
+		else
+		{
+			constexpr int LOG_SIZE = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3;
+			return static_cast<DataType>(1 + 2 * LOG_SIZE + (std::is_signed_v<T> ? 0 : 1));
+		}
+	}
+
+	//=========//
+	// Writing //
+	//=========//
+
+	// the lines of lineLength elements of data, ld elements apart, go to the file at path after the header
+	template<typename T>
+	void WriteFile(const std::string& path, FileHeader header, size_t lines, size_t lineLength, size_t ld, const T* data)
+	{
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		if (!stream) throw std::runtime_error("Save: cannot create " + path);
+
+		const size_t dataOffset = (sizeof(FileHeader) + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.byteOrderMark = BYTE_ORDER_MARK;
+		header.dataType = static_cast<uint8_t>(DataTypeOf<T>());
+		header.elementSize = sizeof(T);
+		header.reserved = 0;
+		header.dataOffset = dataOffset;
+		header.dataBytes = lines * lineLength * sizeof(T);
+		header.checksum = 0;
+
+		// the header is written again at the end, with the checksum
+		const char zeros[DATA_ALIGNMENT] = {};
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(zeros, static_cast<std::streamsize>(dataOffset - sizeof(header)));
+
+		// contiguous lines are written as one
+		if (ld == lineLength || lines <= 1)
+		{
+			lineLength *= lines;
+			lines = lineLength > 0 ? 1 : 0;
+		}
+
+		UTILITIES::Checksum64 checksum;
+		for (size_t i = 0; i < lines; i++)
+		{
+			const char* bytes = reinterpret_cast<const char*>(data + i * ld);
+			size_t remaining = lineLength * sizeof(T);
+			while (remaining > 0)
+			{
+				const size_t n = std::min(remaining, IO_CHUNK_BYTES);
+				checksum.Update(bytes, n);
+				stream.write(bytes, static_cast<std::streamsize>(n));
+				bytes += n;
+				remaining -= n;
+			}
+		}
+
+		header.checksum = checksum.Digest();
+		stream.seekp(0);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.close();
+		if (!stream) throw std::runtime_error("Save: cannot write " + path);
+	}
+
+	template<typename T, StorageOrder Order>
+	void Save(const std::string& path, MatrixView<const T, Order> mat)
+	{
+		FileHeader header{};
+		header.rank = 2;
+		header.storageOrder = static_cast<uint8_t>(Order);
+		header.shape[0] = mat.NRows();
+		header.shape[1] = mat.NCols();
+		const size_t lines = Order == StorageOrder::ROW_MAJOR ? mat.NRows() : mat.NCols();
+		const size_t lineLength = Order == StorageOrder::ROW_MAJOR ? mat.NCols() : mat.NRows();
+		WriteFile(path, header, lines, lineLength, mat.LeadingDimension(), mat.Data());
+	}
+
+	template<typename T, StorageOrder Order>
+	void Save(const std::string& path, MatrixView<T, Order> mat)
+	{
+		Save(path, MatrixView<const T, Order>(mat));
+	}
+
+	template<typename T, typename Allocator, StorageOrder Order>
+	void Save(const std::string& path, const Matrix<T, Allocator, Order>& mat)
+	{
+		Save(path, MatrixView<const T, Order>(mat));
+	}
+
+	template<typename T, typename Allocator>
+	void Save(const std::string& path, const Vector<T, Allocator>& vec)
+	{
+		FileHeader header{};
+		header.rank = 1;
+		header.storageOrder = static_cast<uint8_t>(StorageOrder::ROW_MAJOR);
+		header.shape[0] = vec.Size();
+		header.shape[1] = 1;
+		WriteFile(path, header, 1, vec.Size(), vec.Size(), vec.Data());
+	}
+
+	//=========//
+	// Reading //
+	//=========//
+
+	// checks that the header describes a file of fileSize bytes holding rank-dimensional T elements
+	template<typename T>
+	void ValidateHeader(const FileHeader& header, uint8_t rank, uint64_t fileSize, const std::string& path)
+	{
+		const auto fail = [&path](const std::string& what)
+		{
+			throw std::runtime_error("Load: " + path + ": " + what);
+		};
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) fail("not a SEPOLIA4 binary file");
+		if (header.byteOrderMark != BYTE_ORDER_MARK) fail("written with the other byte order");
+		if (header.version > VERSION) fail("written by a newer version");
+		if (header.rank != rank) fail(header.rank == 1 ? "holds a vector" : "holds a matrix");
+		if (header.dataType != static_cast<uint8_t>(DataTypeOf<T>()) || header.elementSize != sizeof(T))
+		{
+			fail("holds elements of another type");
+		}
+		if (header.storageOrder > static_cast<uint8_t>(StorageOrder::COLUMN_MAJOR)) fail("unknown storage order");
+
+		const uint64_t elements = header.shape[0] * header.shape[1];
+		if ((header.shape[0] != 0 && elements / header.shape[0] != header.shape[1]) ||
+			elements > std::numeric_limits<uint64_t>::max() / sizeof(T) || header.dataBytes != elements * sizeof(T))
+		{
+			fail("the shape does not match the size of the elements");
+		}
+		if (rank == 2 && (header.shape[0] > std::numeric_limits<MatrixIndex>::max() ||
+						  header.shape[1] > std::numeric_limits<MatrixIndex>::max()))
+		{
+			fail("too large for MatrixIndex: build with SEPOLIA4_LARGE_MATRICES");
+		}
+		if (header.dataOffset < sizeof(FileHeader) || header.dataOffset % alignof(T) != 0 ||
+			header.dataOffset > fileSize || fileSize - header.dataOffset < header.dataBytes)
+		{
+			fail("truncated");
+		}
+	}
+
+	// header at the start of stream, the file at path, validated for rank-dimensional T elements
+	template<typename T>
+	FileHeader ReadHeader(std::ifstream& stream, uint8_t rank, const std::string& path)
+	{
+		if (!stream) throw std::runtime_error("Load: cannot open " + path);
+		stream.seekg(0, std::ios::end);
+		const auto fileSize = static_cast<uint64_t>(stream.tellg());
+		stream.seekg(0);
+
+		FileHeader header{};
+		if (fileSize < sizeof(header) || !stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		{
+			throw std::runtime_error("Load: " + path + ": not a SEPOLIA4 binary file");
+		}
+		ValidateHeader<T>(header, rank, fileSize, path);
+		return header;
+	}
+
+	// the elements of the file go to data, in chunks checksummed as they arrive
+	inline void ReadElements(std::ifstream& stream, const FileHeader& header, void* data, const std::string& path)
+	{
+		stream.seekg(static_cast<std::streamoff>(header.dataOffset));
+		UTILITIES::Checksum64 checksum;
+		char* bytes = static_cast<char*>(data);
+		uint64_t remaining = header.dataBytes;
+		while (remaining > 0)
+		{
+			const size_t n = static_cast<size_t>(std::min<uint64_t>(remaining, IO_CHUNK_BYTES));
+			if (!stream.read(bytes, static_cast<std::streamsize>(n))) throw std::runtime_error("Load: " + path + ": truncated");
+			checksum.Update(bytes, n);
+			bytes += n;
+			remaining -= n;
+		}
+		if (checksum.Digest() != header.checksum) throw std::runtime_error("Load: " + path + ": checksum mismatch");
+	}
+
+	// the matrix takes the storage order Order; files of the other order are transposed once read
+	template<typename T, StorageOrder Order = StorageOrder::ROW_MAJOR>
+	[[nodiscard]] Matrix<T, AlignedAllocator<T>, Order> LoadMatrix(const std::string& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		const FileHeader header = ReadHeader<T>(stream, 2, path);
+		const auto nrows = static_cast<MatrixIndex>(header.shape[0]);
+		const auto ncols = static_cast<MatrixIndex>(header.shape[1]);
+
+		if (header.storageOrder == static_cast<uint8_t>(Order))
+		{
+			Matrix<T, AlignedAllocator<T>, Order> res(nrows, ncols, UNINITIALIZED);
+			ReadElements(stream, header, res.Data(), path);
+			return res;
+		}
+		Matrix<T, AlignedAllocator<T>, TransposedOrder(Order)> res(nrows, ncols, UNINITIALIZED);
+		ReadElements(stream, header, res.Data(), path);
+		return Matrix<T, AlignedAllocator<T>, Order>(std::move(res));
+	}
+
+	template<typename T>
+	[[nodiscard]] Vector<T> LoadVector(const std::string& path)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		const FileHeader header = ReadHeader<T>(stream, 1, path);
+		Vector<T> res(static_cast<size_t>(header.shape[0]), UNINITIALIZED);
+		ReadElements(stream, header, res.Data(), path);
+		return res;
+	}
+
+	// maps the file at path and validates its header for rank-dimensional T elements
+	template<typename T>
+	std::shared_ptr<UTILITIES::MappedFile> MapFile(const std::string& path, uint8_t rank, UTILITIES::MapMode mode,
+			bool verifyChecksum, FileHeader& header)
+	{
+		auto file = std::make_shared<UTILITIES::MappedFile>(path, mode);
+		if (file->Size() < sizeof(header)) throw std::runtime_error("Load: " + path + ": not a SEPOLIA4 binary file");
+		std::memcpy(&header, file->Data(), sizeof(header));
+		ValidateHeader<T>(header, rank, file->Size(), path);
+		if (verifyChecksum && UTILITIES::Checksum64::Compute(file->Data() + header.dataOffset, header.dataBytes) != header.checksum)
+		{
+			throw std::runtime_error("Load: " + path + ": checksum mismatch");
+		}
+		return file;
+	}
+
+	// zero-copy load: the matrix lives on the mapping (see the Matrix constructor taking a MappedFile),
+	// so the file must have the storage order Order; writes stay in private pages through the default
+	// COPY_ON_WRITE mappings and go to the file through READ_WRITE ones; READ_ONLY mappings cannot back
+	// a matrix and throw std::invalid_argument
+	template<typename T, StorageOrder Order = StorageOrder::ROW_MAJOR>
+	[[nodiscard]] Matrix<T, AlignedAllocator<T>, Order> MapMatrix(const std::string& path,
+			UTILITIES::MapMode mode = UTILITIES::MapMode::COPY_ON_WRITE, bool verifyChecksum = false)
+	{
+		FileHeader header{};
+		auto file = MapFile<T>(path, 2, mode, verifyChecksum, header);
+		if (header.storageOrder != static_cast<uint8_t>(Order))
+		{
+			throw std::runtime_error("Load: " + path + ": the storage order differs, it cannot be mapped as it is");
+		}
+		return Matrix<T, AlignedAllocator<T>, Order>(static_cast<MatrixIndex>(header.shape[0]),
+				static_cast<MatrixIndex>(header.shape[1]), std::move(file), header.dataOffset);
+	}
+
+	template<typename T>
+	[[nodiscard]] Vector<T> MapVector(const std::string& path,
+			UTILITIES::MapMode mode = UTILITIES::MapMode::COPY_ON_WRITE, bool verifyChecksum = false)
+	{
+		FileHeader header{};
+		auto file = MapFile<T>(path, 1, mode, verifyChecksum, header);
+		return Vector<T>(static_cast<size_t>(header.shape[0]), std::move(file), header.dataOffset);
+	}
+}
@@ -1,30 +1,111 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 #include <iostream>
+#include <stdexcept>
+#include "VectorExpression.h"
+#include "VectorView.h"
+#include "../Memory/AlignedAllocator.h"
+#include "../Memory/Uninitialized.h"
+#include "../Memory/FirstTouch.h"
+#include "../Kernels/SimdKernels.h"
+#include "../Kernels/ReductionKernels.h"
+#include "../Kernels/BlasKernels.h"
+#include "../../Utilities/MappedFile.h"
 
 namespace SEPOLIA4::CONTAINERS
 {
-	template<typename T>
-	class Vector final
+	template<typename T, typename Allocator = AlignedAllocator<T>>
+	class Vector final : public VectorExpression<Vector<T, Allocator>>
 	{
+		using AllocatorTraits = std::allocator_traits<Allocator>;
+
 	public:
 
+		using ValueType = T;
+		using AllocatorType = Allocator;
+
+		//===================================================================//
+		// Small-buffer optimization: vectors of trivially copyable types    //
+		// that fit in SMALL_BUFFER_SIZE bytes live inside the object and    //
+		// never touch the allocator (16 doubles, 32 floats). The buffer is  //
+		// cache-line aligned, so it is disabled for allocators that promise //
+		// a stronger alignment than that.                                   //
+		//===================================================================//
+
+		static constexpr size_t SMALL_BUFFER_SIZE = 128;
+
+		static constexpr size_t INLINE_CAPACITY =
+				std::is_trivially_copyable_v<T> &&
+				std::is_trivially_destructible_v<T> &&
+				AllocatorAlignment<Allocator>::value <= CACHE_LINE_SIZE ? SMALL_BUFFER_SIZE / sizeof(T) : 0;
+
 		//==============//
 		// Constructors //
 		//==============//
 
 		Vector() = default;
 
+		explicit Vector(const Allocator& allocator) : m_allocator(allocator)
+		{
+		}
+
 		explicit Vector(size_t size)
 		{
 			Allocate(size);
 		}
 
+		Vector(size_t size, const Allocator& allocator) : m_allocator(allocator)
+		{
+			Allocate(size);
+		}
+
+		Vector(size_t size, UninitializedTag)
+		{
+			AllocateUninitialized(size);
+		}
+
+		Vector(size_t size, UninitializedTag, const Allocator& allocator) : m_allocator(allocator)
+		{
+			AllocateUninitialized(size);
+		}
+
+		Vector(size_t size, ParallelFirstTouchTag)
+		{
+			Allocate(size, PARALLEL_FIRST_TOUCH);
+		}
+
+		Vector(size_t size, ParallelFirstTouchTag, const Allocator& allocator) : m_allocator(allocator)
+		{
+			Allocate(size, PARALLEL_FIRST_TOUCH);
+		}
+
+		// the elements are the bytes of file from offset on, used in place, as for the Matrix
+		// constructor (READ_ONLY mappings are rejected: use a VectorView<const T> on them);
+		// growing past the size moves them to allocated storage
+		Vector(size_t size, std::shared_ptr<UTILITIES::MappedFile> file, size_t offset = 0)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can live in a mapped file");
+			if (!file || offset % alignof(T) != 0 || offset > file->Size() || (file->Size() - offset) / sizeof(T) < size)
+			{
+				throw std::invalid_argument("Vector: the file cannot hold the vector at this offset");
+			}
+			if (file->GetMode() == UTILITIES::MapMode::READ_ONLY)
+			{
+				throw std::invalid_argument("Vector: a read-only mapping cannot back a writable vector");
+			}
+			m_data = size == 0 ? nullptr : reinterpret_cast<T*>(file->Data() + offset);
+			m_size = size;
+			m_capacity = size;
+			m_file = std::move(file);
+		}
+
 		explicit Vector(const std::vector<T>& vec)
 		{
-			Allocate(vec.size());
+			AllocateUninitialized(vec.size());
 			for (size_t i = 0; i < vec.size(); i++)
 			{
 				m_data[i] = vec[i];
@@ -33,7 +114,7 @@ namespace SEPOLIA4::CONTAINERS
 
 		Vector(const std::initializer_list<T>& initList)
 		{
-			Allocate(initList.size());
+			AllocateUninitialized(initList.size());
 			size_t idx = 0;
 			for (const auto& el : initList)
 			{
@@ -42,12 +123,12 @@ namespace SEPOLIA4::CONTAINERS
 			}
 		}
 
-		Vector(const Vector& other)
+		Vector(const Vector& other) :
+				m_allocator(AllocatorTraits::select_on_container_copy_construction(other.m_allocator))
 		{
 			if (this != &other)
 			{
-				Allocate(other.m_size);
-				m_size = other.m_size;
+				AllocateUninitialized(other.m_size);
 				for (size_t i = 0; i < m_size; i++)
 				{
 					m_data[i] = other.m_data[i];
@@ -59,7 +140,7 @@ namespace SEPOLIA4::CONTAINERS
 		{
 			if (this != &other)
 			{
-				Allocate(other.m_size);
+				if (m_size != other.m_size || !m_data) AllocateUninitialized(other.m_size);
 				for (size_t i = 0; i < m_size; i++)
 				{
 					m_data[i] = other.m_data[i];
@@ -68,15 +149,11 @@ namespace SEPOLIA4::CONTAINERS
 			return *this;
 		}
 
-		Vector(Vector&& other) noexcept
+		Vector(Vector&& other) noexcept : m_allocator(std::move(other.m_allocator))
 		{
 			if (this != &other)
 			{
-				if (m_data) Deallocate();
-				m_data = std::move(other.m_data);
-				m_size = other.m_size;
-				other.m_data = nullptr;
-				other.m_size = 0;
+				StealFrom(other);
 			}
 		}
 
@@ -85,42 +162,144 @@ namespace SEPOLIA4::CONTAINERS
 			if (this != &other)
 			{
 				if (m_data) Deallocate();
-				m_data = std::move(other.m_data);
-				m_size = other.m_size;
-				other.m_data = nullptr;
-				other.m_size = 0;
+				m_allocator = std::move(other.m_allocator);
+				StealFrom(other);
 			}
 			return *this;
 		}
 
-		~Vector() = default;
+		template<typename E>
+		Vector(const VectorExpression<E>& expr)
+		{
+			const auto& e = expr.Derived();
+			AllocateUninitialized(e.Size());
+			Evaluate(EXECUTION::PAR_UNSEQ, e);
+		}
+
+		template<typename E>
+		Vector& operator=(const VectorExpression<E>& expr)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, expr);
+		}
+
+		~Vector()
+		{
+			Deallocate();
+		}
 
 		//===================//
 		// Memory management //
 		//===================//
 
 		bool Allocate(size_t size)
+		{
+			return AllocateStorage(size, Initialization::SERIAL);
+		}
+
+		// the elements are initialized in parallel, chunk by chunk, by the threads of the parallel kernels
+		bool Allocate(size_t size, ParallelFirstTouchTag)
+		{
+			return AllocateStorage(size, Initialization::PARALLEL_FIRST_TOUCH);
+		}
+
+		// the elements of trivial types are left indeterminate: use it only when they are written next
+		bool AllocateUninitialized(size_t size)
+		{
+			return AllocateStorage(size, std::is_trivially_default_constructible_v<T> ? Initialization::NONE : Initialization::SERIAL);
+		}
+
+		bool Deallocate()
+		{
+			if (m_file)
+			{
+				m_file.reset();
+			}
+			else if (m_data && !IsInline())
+			{
+				for (size_t i = 0; i < m_size; i++)
+				{
+					AllocatorTraits::destroy(m_allocator, m_data + i);
+				}
+				AllocatorTraits::deallocate(m_allocator, m_data, m_capacity);
+			}
+			m_data = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+			return true;
+		}
+
+		//====================================================================//
+		// Growth: the capacity at least doubles whenever it is exceeded, so  //
+		// appending is amortized O(1). Heap blocks of trivially copyable     //
+		// types are grown through the allocator's reallocate() when it has   //
+		// one, which for large AlignedAllocator blocks remaps the pages with //
+		// mremap instead of copying the elements.                            //
+		//====================================================================//
+
+		bool Reserve(size_t capacity)
 		{
 			try
 			{
-				if (m_data) Deallocate();
-				m_data = std::make_unique<T[]>(size);
+				if (capacity > m_capacity) Grow(capacity);
+				return true;
+			}
+			catch (std::exception& e)
+			{
+				std::cout << e.what() << std::endl;
+			}
+			return false;
+		}
+
+		// new elements are value-initialized, trailing elements are destroyed when shrinking
+		bool Resize(size_t size)
+		{
+			try
+			{
+				if (size > m_capacity) Grow(NextCapacity(size));
+				for (size_t i = m_size; i < size; i++)
+				{
+					AllocatorTraits::construct(m_allocator, m_data + i);
+				}
+				for (size_t i = size; i < m_size; i++)
+				{
+					AllocatorTraits::destroy(m_allocator, m_data + i);
+				}
 				m_size = size;
 				return true;
 			}
 			catch (std::exception& e)
 			{
-				m_data.reset(nullptr);
 				std::cout << e.what() << std::endl;
 			}
 			return false;
 		}
 
-		bool Deallocate()
+		void PushBack(const T& val)
 		{
-			m_data.reset(nullptr);
-			m_size = 0;
-			return true;
+			EmplaceBack(val);
+		}
+
+		void PushBack(T&& val)
+		{
+			EmplaceBack(std::move(val));
+		}
+
+		template<typename... Args>
+		T& EmplaceBack(Args&& ... args)
+		{
+			if (m_size == m_capacity)
+			{
+				// the arguments may refer to an element of this vector: build the new one before growing
+				T val(std::forward<Args>(args)...);
+				Grow(NextCapacity(m_size + 1));
+				AllocatorTraits::construct(m_allocator, m_data + m_size, std::move(val));
+			}
+			else
+			{
+				AllocatorTraits::construct(m_allocator, m_data + m_size, std::forward<Args>(args)...);
+			}
+			m_size++;
+			return m_data[m_size - 1];
 		}
 
 		[[nodiscard]] bool IsAllocated() const
@@ -134,11 +313,39 @@ namespace SEPOLIA4::CONTAINERS
 			return !IsAllocated();
 		}
 
+		// true when the elements live in the small buffer inside the object
+		[[nodiscard]] bool IsInline() const
+		{
+			return m_data != nullptr && m_data == InlineData();
+		}
+
+		// true when the elements live in a mapped file
+		[[nodiscard]] bool IsMapped() const
+		{
+			return m_file != nullptr;
+		}
+
+		// the mapping the elements live in, if any: use it for access hints (MappedFile::Advise) and Sync
+		[[nodiscard]] const std::shared_ptr<UTILITIES::MappedFile>& GetMappedFile() const
+		{
+			return m_file;
+		}
+
 		[[nodiscard]] size_t Size() const
 		{
 			return m_size;
 		}
 
+		[[nodiscard]] size_t Capacity() const
+		{
+			return m_capacity;
+		}
+
+		[[nodiscard]] Allocator GetAllocator() const
+		{
+			return m_allocator;
+		}
+
 		//======================================//
 		// Operators to access and set elements //
 		//======================================//
@@ -153,166 +360,285 @@ namespace SEPOLIA4::CONTAINERS
 			return m_data[idx];
 		}
 
-		//================//
-		// Check equality //
-		//================//
+		const T& operator[](size_t idx) const
+		{
+			return m_data[idx];
+		}
+
+		T* Data()
+		{
+			return m_data;
+		}
 
-		bool operator==(const Vector& rhs) const
+		[[nodiscard]] const T* Data() const
 		{
-			if (m_size != rhs.Size()) return false;
-			for (size_t i = 0; i < rhs.Size(); i++)
-			{
-				if (m_data[i] != rhs.m_data[i]) return false;
-			}
-			return true;
+			return m_data;
 		}
 
-		bool operator==(T val) const
+		//====================================================//
+		// Views of size elements starting at offset, taking  //
+		// every stride-th one; they do not copy the elements //
+		//====================================================//
+
+		[[nodiscard]] VectorView<T> Slice(size_t offset, size_t size, size_t stride = 1)
 		{
-			for (size_t i = 0; i < Size(); i++)
+			return VectorView<T>(m_data + offset, size, stride);
+		}
+
+		[[nodiscard]] VectorView<const T> Slice(size_t offset, size_t size, size_t stride = 1) const
+		{
+			return VectorView<const T>(m_data + offset, size, stride);
+		}
+
+		//=================================================================//
+		// Reductions. Without a policy argument they use PAR_UNSEQ: SIMD  //
+		// kernels, on all the worker threads for large vectors. Min, Max, //
+		// MinMax, ArgMin and ArgMax need a non-empty vector.              //
+		//=================================================================//
+
+		template<typename Policy>
+		[[nodiscard]] T Sum(Policy policy, Summation summation = Summation::FAST) const
+		{
+			return KERNELS::SumAll(policy, m_data, m_size, summation);
+		}
+
+		[[nodiscard]] T Sum(Summation summation = Summation::FAST) const
+		{
+			return Sum(EXECUTION::PAR_UNSEQ, summation);
+		}
+
+		// other is a Vector or a view
+		template<typename Policy>
+		[[nodiscard]] T Dot(Policy policy, VectorView<const T> other) const
+		{
+			if (KERNELS::UseBlas<T>(policy, m_size, KERNELS::BLAS_MIN_LEVEL1_SIZE, m_size, other.Stride()))
 			{
-				if (m_data[i] != val) return false;
+				return KERNELS::BlasDot(m_size, m_data, 1, other.Data(), other.Stride());
 			}
-			return true;
+			return KERNELS::DotAll(policy, m_data, other.Data(), m_size, 1, other.Stride());
 		}
 
-		template<typename U>
-		friend bool operator==(U val, const Vector<U>& rhs)
+		[[nodiscard]] T Dot(VectorView<const T> other) const
 		{
-			return rhs == val;
+			return Dot(EXECUTION::PAR_UNSEQ, other);
 		}
 
-		bool operator!=(const Vector& rhs) const
+		// Euclidean norm
+		template<typename Policy>
+		[[nodiscard]] T Norm2(Policy policy) const
 		{
-			return !(*this == rhs);
+			return static_cast<T>(std::sqrt(Dot(policy, *this)));
 		}
 
-		bool operator!=(T val) const
+		[[nodiscard]] T Norm2() const
 		{
-			return !(*this == val);
+			return Norm2(EXECUTION::PAR_UNSEQ);
 		}
 
-		template<typename U>
-		friend bool operator!=(U val, const Vector<U>& rhs)
+		template<typename Policy>
+		[[nodiscard]] T Min(Policy policy) const
 		{
-			return rhs != val;
+			return KERNELS::ReduceAll<OPERATIONS::Min>(policy, m_data, m_size);
 		}
 
-		//======================//
-		// arithmetic operators //
-		//======================//
+		[[nodiscard]] T Min() const
+		{
+			return Min(EXECUTION::PAR_UNSEQ);
+		}
 
-		//=============//
-		// operator: + //
-		//=============//
+		template<typename Policy>
+		[[nodiscard]] T Max(Policy policy) const
+		{
+			return KERNELS::ReduceAll<OPERATIONS::Max>(policy, m_data, m_size);
+		}
 
-		Vector operator+(const Vector& rhs) const
+		[[nodiscard]] T Max() const
 		{
-			Vector<T> res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < rhs.Size(); i++)
-			{
-				res.m_data[i] = m_data[i] + rhs.m_data[i];
-			}
-			return std::move(res);
+			return Max(EXECUTION::PAR_UNSEQ);
 		}
 
-		Vector operator+(T val) const
+		template<typename Policy>
+		[[nodiscard]] std::pair<T, T> MinMax(Policy policy) const
 		{
-			Vector<T> res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < m_size; i++)
-			{
-				res.m_data[i] = m_data[i] + val;
-			}
-			return std::move(res);
+			return KERNELS::MinMaxAll(policy, m_data, m_size);
 		}
 
-		template<typename U>
-		friend Vector<U> operator+(U val, const Vector<U>& rhs)
+		[[nodiscard]] std::pair<T, T> MinMax() const
 		{
-			Vector<T> res;
-			res.Allocate(rhs.m_size);
-			for (size_t i = 0; i < rhs.m_size; i++)
-			{
-				res.m_data[i] = val + rhs.m_data[i];
-			}
-			return std::move(res);
+			return MinMax(EXECUTION::PAR_UNSEQ);
 		}
 
-		void operator++()
+		// index of the first smallest element
+		template<typename Policy>
+		[[nodiscard]] size_t ArgMin(Policy policy) const
 		{
-			for (size_t i = 0; i < m_size; i++)
+			return KERNELS::ArgReduceAll<OPERATIONS::Min>(policy, m_data, m_size);
+		}
+
+		[[nodiscard]] size_t ArgMin() const
+		{
+			return ArgMin(EXECUTION::PAR_UNSEQ);
+		}
+
+		// index of the first largest element
+		template<typename Policy>
+		[[nodiscard]] size_t ArgMax(Policy policy) const
+		{
+			return KERNELS::ArgReduceAll<OPERATIONS::Max>(policy, m_data, m_size);
+		}
+
+		[[nodiscard]] size_t ArgMax() const
+		{
+			return ArgMax(EXECUTION::PAR_UNSEQ);
+		}
+
+		//==================================================================//
+		// Operations with an execution policy (EXECUTION::SEQ, UNSEQ, PAR, //
+		// PAR_UNSEQ). The operators below are these with PAR_UNSEQ.        //
+		// Assign(policy, other) with another Vector is a copy.             //
+		//==================================================================//
+
+		template<typename Policy, typename E>
+		Vector& Assign(Policy policy, const VectorExpression<E>& expr)
+		{
+			const auto& e = expr.Derived();
+			if (m_size == e.Size())
 			{
-				m_data[i]++;
+				// elementwise expressions only read index i to write index i,
+				// so they can be evaluated straight into the existing storage
+				Evaluate(policy, e);
 			}
+			else
+			{
+				// the expression may refer to this vector: build aside, then move in
+				Vector res(m_allocator);
+				res.AllocateUninitialized(e.Size());
+				res.Evaluate(policy, e);
+				*this = std::move(res);
+			}
+			return *this;
 		}
 
-		void operator++(int)
+		template<typename Policy, typename E>
+		Vector& Add(Policy policy, const VectorExpression<E>& rhs)
 		{
-			++(*this);
+			CompoundAssign<OPERATIONS::Plus>(policy, rhs.Derived());
+			return *this;
 		}
 
-		Vector& operator+=(const Vector& rhs)
+		template<typename Policy>
+		Vector& Add(Policy policy, T val)
 		{
-			*this = *this + rhs;
+			CompoundAssignScalar<OPERATIONS::Plus>(policy, val);
 			return *this;
 		}
 
-		Vector& operator+=(T val)
+		template<typename Policy, typename E>
+		Vector& Subtract(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Minus>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		Vector& Subtract(Policy policy, T val)
 		{
-			*this = *this + val;
+			CompoundAssignScalar<OPERATIONS::Minus>(policy, val);
 			return *this;
 		}
 
-		//=============//
-		// operator: - //
-		//=============//
+		template<typename Policy, typename E>
+		Vector& Multiply(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Multiplies>(policy, rhs.Derived());
+			return *this;
+		}
 
-		Vector operator-(const Vector& rhs) const
+		template<typename Policy>
+		Vector& Multiply(Policy policy, T val)
 		{
-			Vector res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < rhs.Size(); i++)
-			{
-				res.m_data[i] = m_data[i] - rhs.m_data[i];
-			}
-			return std::move(res);
+			CompoundAssignScalar<OPERATIONS::Multiplies>(policy, val);
+			return *this;
 		}
 
-		Vector operator-(T val) const
+		template<typename Policy, typename E>
+		Vector& Divide(Policy policy, const VectorExpression<E>& rhs)
 		{
-			Vector res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < m_size; i++)
+			CompoundAssign<OPERATIONS::Divides>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		Vector& Divide(Policy policy, T val)
+		{
+			CompoundAssignScalar<OPERATIONS::Divides>(policy, val);
+			return *this;
+		}
+
+		// this += alpha * x, with x a Vector or a view of the same size
+		template<typename Policy>
+		Vector& Axpy(Policy policy, T alpha, VectorView<const T> x)
+		{
+			const T* const b = x.Data();
+			const size_t stride = x.Stride();
+			T* const c = m_data;
+			if (KERNELS::UseBlas<T>(policy, m_size, KERNELS::BLAS_MIN_LEVEL1_SIZE, m_size, stride))
 			{
-				res.m_data[i] = m_data[i] - val;
+				KERNELS::BlasAxpy(m_size, alpha, b, stride, c, 1);
+				return *this;
 			}
-			return std::move(res);
+			KERNELS::ForChunks<T>(policy, m_size, [alpha, b, stride, c](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					c[i] += alpha * b[i * stride];
+				}
+			});
+			return *this;
 		}
 
-		template<typename U>
-		friend Vector<U> operator-(U val, const Vector<U>& rhs)
+		Vector& Axpy(T alpha, VectorView<const T> x)
 		{
-			Vector<T> res;
-			res.Allocate(rhs.m_size);
-			for (size_t i = 0; i < rhs.m_size; i++)
+			return Axpy(EXECUTION::PAR_UNSEQ, alpha, x);
+		}
+
+		template<typename Policy>
+		Vector& Fill(Policy policy, T val)
+		{
+			T* const data = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [data, val](size_t begin, size_t end)
 			{
-				res.m_data[i] = val - rhs.m_data[i];
-			}
-			return std::move(res);
+				std::fill(data + begin, data + end, val);
+			});
+			return *this;
 		}
 
-		template<typename U>
-		friend Vector<U> operator-(const Vector<U>& rhs)
+		//===============================//
+		// Compound assignment operators //
+		//===============================//
+
+		void operator++()
 		{
-			Vector<T> res;
-			res.Allocate(rhs.m_size);
-			for (size_t i = 0; i < rhs.m_size; i++)
+			for (size_t i = 0; i < m_size; i++)
 			{
-				res.m_data[i] = -rhs.m_data[i];
+				m_data[i]++;
 			}
-			return std::move(res);
+		}
+
+		void operator++(int)
+		{
+			++(*this);
+		}
+
+		template<typename E>
+		Vector& operator+=(const VectorExpression<E>& rhs)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		Vector& operator+=(T val)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, val);
 		}
 
 		void operator--()
@@ -328,134 +654,302 @@ namespace SEPOLIA4::CONTAINERS
 			--(*this);
 		}
 
-		Vector& operator-=(const Vector& rhs)
+		template<typename E>
+		Vector& operator-=(const VectorExpression<E>& rhs)
 		{
-			*this = *this - rhs;
-			return *this;
+			return Subtract(EXECUTION::PAR_UNSEQ, rhs);
 		}
 
 		Vector& operator-=(T val)
 		{
-			*this = *this - val;
-			return *this;
+			return Subtract(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		Vector& operator*=(const VectorExpression<E>& rhs)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, rhs);
 		}
 
-		//=============//
-		// operator: * //
-		//=============//
+		Vector& operator*=(T val)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, val);
+		}
 
-		Vector operator*(const Vector& rhs) const
+		template<typename E>
+		Vector& operator/=(const VectorExpression<E>& rhs)
 		{
-			Vector res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < rhs.Size(); i++)
+			return Divide(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		Vector& operator/=(T val)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		//============================//
+		// Assignment value operators //
+		//============================//
+
+		Vector& operator=(T val)
+		{
+			return Fill(EXECUTION::PAR_UNSEQ, val);
+		}
+
+	private:
+
+		enum class Initialization
+		{
+			NONE,
+			SERIAL,
+			PARALLEL_FIRST_TOUCH
+		};
+
+		bool AllocateStorage(size_t size, Initialization initialization)
+		{
+			try
 			{
-				res.m_data[i] = m_data[i] * rhs.m_data[i];
+				if (m_data) Deallocate();
+				if (size <= INLINE_CAPACITY)
+				{
+					m_data = InlineData();
+					m_capacity = INLINE_CAPACITY;
+					if (initialization != Initialization::NONE)
+					{
+						std::fill_n(m_data, size, T());
+					}
+				}
+				else
+				{
+					m_data = AllocatorTraits::allocate(m_allocator, size);
+					m_capacity = size;
+					if (initialization == Initialization::SERIAL)
+					{
+						for (size_t i = 0; i < size; i++)
+						{
+							AllocatorTraits::construct(m_allocator, m_data + i);
+						}
+					}
+					else if (initialization == Initialization::PARALLEL_FIRST_TOUCH)
+					{
+						ParallelFirstTouch(m_allocator, m_data, size);
+					}
+				}
+				m_size = size;
+				return true;
+			}
+			catch (std::exception& e)
+			{
+				m_data = nullptr;
+				m_capacity = 0;
+				std::cout << e.what() << std::endl;
 			}
-			return std::move(res);
+			return false;
 		}
 
-		Vector operator*(T val) const
+		[[nodiscard]] size_t NextCapacity(size_t size) const
 		{
-			Vector<T> res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < m_size; i++)
+			return std::max(size, 2 * m_capacity);
+		}
+
+		// moves the elements to storage for capacity elements, capacity > m_capacity
+		void Grow(size_t capacity)
+		{
+			if (!m_data && capacity <= INLINE_CAPACITY)
+			{
+				m_file.reset();
+				m_data = InlineData();
+				m_capacity = INLINE_CAPACITY;
+				return;
+			}
+
+			if constexpr (std::is_trivially_copyable_v<T> && HasReallocate<Allocator>::value)
+			{
+				if (m_data && !IsInline() && !m_file)
+				{
+					m_data = m_allocator.reallocate(m_data, m_capacity, capacity);
+					m_capacity = capacity;
+					return;
+				}
+			}
+
+			T* data = AllocatorTraits::allocate(m_allocator, capacity);
+			size_t idx = 0;
+			try
+			{
+				for (; idx < m_size; idx++)
+				{
+					AllocatorTraits::construct(m_allocator, data + idx, std::move_if_noexcept(m_data[idx]));
+				}
+			}
+			catch (...)
 			{
-				res.m_data[i] = m_data[i] * val;
+				for (size_t i = 0; i < idx; i++)
+				{
+					AllocatorTraits::destroy(m_allocator, data + i);
+				}
+				AllocatorTraits::deallocate(m_allocator, data, capacity);
+				throw;
+			}
+
+			// the elements of a mapped vector stay in the file
+			if (m_file)
+			{
+				m_file.reset();
+			}
+			else if (m_data && !IsInline())
+			{
+				for (size_t i = 0; i < m_size; i++)
+				{
+					AllocatorTraits::destroy(m_allocator, m_data + i);
+				}
+				AllocatorTraits::deallocate(m_allocator, m_data, m_capacity);
 			}
-			return std::move(res);
+			m_data = data;
+			m_capacity = capacity;
 		}
 
-		template<typename U>
-		friend Vector<U> operator*(U val, const Vector<U>& rhs)
+		//========================================//
+		// Fused evaluation of an expression tree //
+		//========================================//
+
+		// large vectors are evaluated chunk by chunk on the worker threads under parallel policies
+
+		template<typename Policy, typename E>
+		void Evaluate(Policy policy, const E& e)
 		{
-			Vector<T> res;
-			res.Allocate(rhs.m_size);
-			for (size_t i = 0; i < rhs.m_size; i++)
+			T* const data = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [data, &e](size_t begin, size_t end)
 			{
-				res.m_data[i] = val * rhs.m_data[i];
-			}
-			return std::move(res);
+				for (size_t i = begin; i < end; i++)
+				{
+					data[i] = e[i];
+				}
+			});
 		}
 
-		Vector& operator*=(const Vector& rhs)
+		// single-operation expressions on whole vectors go to the SIMD kernels
+
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const VectorBinaryExpression<Vector, Vector, Op>& e)
 		{
-			*this = *this * rhs;
-			return *this;
+			const T* const a = e.Lhs().Data();
+			const T* const b = e.Rhs().Data();
+			T* const c = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [policy, a, b, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, a + begin, b + begin, c + begin, end - begin);
+			});
 		}
 
-		Vector& operator*=(T val)
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const VectorScalarExpression<Vector, Op>& e)
 		{
-			*this = *this * val;
-			return *this;
+			const T* const a = e.Lhs().Data();
+			const T val = e.Scalar();
+			T* const c = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [policy, a, val, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, a + begin, val, c + begin, end - begin);
+			});
+		}
+
+		template<typename Policy, typename Op>
+		void Evaluate(Policy policy, const ScalarVectorExpression<Vector, Op>& e)
+		{
+			const T val = e.Scalar();
+			const T* const b = e.Rhs().Data();
+			T* const c = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [policy, val, b, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, val, b + begin, c + begin, end - begin);
+			});
 		}
 
-		//=============//
-		// operator: / //
-		//=============//
+		//======================================//
+		// In-place compound assignment kernels //
+		//======================================//
 
-		Vector operator/(const Vector& rhs) const
+		template<typename Op, typename Policy, typename E>
+		void CompoundAssign(Policy policy, const E& e)
 		{
-			Vector<T> res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < rhs.Size(); i++)
+			T* const data = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [data, &e](size_t begin, size_t end)
 			{
-				res.m_data[i] = m_data[i] / rhs.m_data[i];
-			}
-			return std::move(res);
+				for (size_t i = begin; i < end; i++)
+				{
+					data[i] = Op::Apply(data[i], e[i]);
+				}
+			});
 		}
 
-		Vector operator/(T val) const
+		template<typename Op, typename Policy>
+		void CompoundAssign(Policy policy, const Vector& v)
 		{
-			Vector<T> res;
-			res.Allocate(m_size);
-			for (size_t i = 0; i < m_size; i++)
+			const T* const b = v.Data();
+			T* const c = m_data;
+			KERNELS::ForChunks<T>(policy, m_size, [policy, b, c](size_t begin, size_t end)
 			{
-				res.m_data[i] = m_data[i] / val;
-			}
-			return std::move(res);
+				KERNELS::Binary<Op>(policy, c + begin, b + begin, c + begin, end - begin);
+			});
 		}
 
-		template<typename U>
-		friend Vector<U> operator/(U val, const Vector<U>& rhs)
+		template<typename Op, typename Policy>
+		void CompoundAssignScalar(Policy policy, T val)
 		{
-			Vector<T> res;
-			res.Allocate(rhs.m_size);
-			for (size_t i = 0; i < rhs.m_size; i++)
+			T* const c = m_data;
+			if constexpr (std::is_same_v<Op, OPERATIONS::Multiplies>)
 			{
-				res.m_data[i] = val / rhs.m_data[i];
+				// BLAS may set x * 0 to 0 without looking at x, so NaNs and infinities stay native
+				if (val != T(0) && KERNELS::UseBlas<T>(policy, m_size, KERNELS::BLAS_MIN_LEVEL1_SIZE, m_size))
+				{
+					KERNELS::BlasScal(m_size, val, c, 1);
+					return;
+				}
 			}
-			return std::move(res);
+			KERNELS::ForChunks<T>(policy, m_size, [policy, val, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, c + begin, val, c + begin, end - begin);
+			});
 		}
 
-		Vector& operator/=(const Vector& rhs)
+		T* InlineData()
 		{
-			*this = *this / rhs;
-			return *this;
+			return reinterpret_cast<T*>(m_inline);
 		}
 
-		Vector& operator/=(T val)
+		[[nodiscard]] const T* InlineData() const
 		{
-			*this = *this / val;
-			return *this;
+			return reinterpret_cast<const T*>(m_inline);
 		}
 
-		//============================//
-		// Assignment value operators //
-		//============================//
-
-		Vector& operator=(T val)
+		// takes over the elements of other and leaves it empty
+		void StealFrom(Vector& other) noexcept
 		{
-			for (size_t i = 0; i < m_size; i++)
+			if (other.IsInline())
 			{
-				m_data[i] = val;
+				// the elements live inside the other object: copy them over
+				std::copy_n(other.m_data, other.m_size, InlineData());
+				m_data = InlineData();
 			}
-			return *this;
+			else
+			{
+				m_data = other.m_data;
+			}
+			m_size = other.m_size;
+			m_capacity = other.m_capacity;
+			m_file = std::move(other.m_file);
+			other.m_data = nullptr;
+			other.m_size = 0;
+			other.m_capacity = 0;
 		}
 
-	private:
-
-		std::unique_ptr<T[]> m_data;
+		T* m_data = nullptr;
 		size_t m_size = 0;
+		size_t m_capacity = 0;
+		Allocator m_allocator;
+		std::shared_ptr<UTILITIES::MappedFile> m_file;
+		alignas(INLINE_CAPACITY > 0 ? std::max(CACHE_LINE_SIZE, alignof(T)) : alignof(T))
+		unsigned char m_inline[INLINE_CAPACITY > 0 ? INLINE_CAPACITY * sizeof(T) : 1];
 	};
 }
\ No newline at end of file
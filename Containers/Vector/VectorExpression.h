@@ -0,0 +1,345 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include "../Expressions/Operations.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	template<typename T, typename Allocator>
+	class Vector;
+
+	//====================================================================//
+	// Base class of every vector expression (CRTP).                      //
+	// The derived class provides ValueType, Size() and operator[] const. //
+	// Nothing is computed until the expression is assigned to a Vector,  //
+	// which then evaluates the whole tree in one loop.                   //
+	//====================================================================//
+
+	template<typename E>
+	class VectorExpression
+	{
+	public:
+
+		[[nodiscard]] const E& Derived() const
+		{
+			return static_cast<const E&>(*this);
+		}
+
+		[[nodiscard]] auto At(size_t idx) const
+		{
+			return Derived()[idx];
+		}
+
+	protected:
+
+		VectorExpression() = default;
+	};
+
+	//===================================================================//
+	// Containers are held by reference inside an expression tree, while //
+	// the (small) intermediate expression nodes are held by value.      //
+	//===================================================================//
+
+	template<typename E>
+	struct IsVectorLeaf
+	{
+		static constexpr bool value = false;
+	};
+
+	template<typename T, typename Allocator>
+	struct IsVectorLeaf<Vector<T, Allocator>>
+	{
+		static constexpr bool value = true;
+	};
+
+	template<typename E>
+	using VectorOperand = std::conditional_t<IsVectorLeaf<E>::value, const E&, const E>;
+
+	//========================//
+	// expression: lhs op rhs //
+	//========================//
+
+	template<typename L, typename R, typename Op>
+	class VectorBinaryExpression final : public VectorExpression<VectorBinaryExpression<L, R, Op>>
+	{
+	public:
+
+		using ValueType = typename L::ValueType;
+
+		VectorBinaryExpression(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs)
+		{
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_lhs.Size();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_lhs[idx], m_rhs[idx]);
+		}
+
+		[[nodiscard]] const L& Lhs() const
+		{
+			return m_lhs;
+		}
+
+		[[nodiscard]] const R& Rhs() const
+		{
+			return m_rhs;
+		}
+
+	private:
+
+		VectorOperand<L> m_lhs;
+		VectorOperand<R> m_rhs;
+	};
+
+	//===========================//
+	// expression: lhs op scalar //
+	//===========================//
+
+	template<typename E, typename Op>
+	class VectorScalarExpression final : public VectorExpression<VectorScalarExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		VectorScalarExpression(const E& lhs, ValueType val) : m_lhs(lhs), m_val(val)
+		{
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_lhs.Size();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_lhs[idx], m_val);
+		}
+
+		[[nodiscard]] const E& Lhs() const
+		{
+			return m_lhs;
+		}
+
+		[[nodiscard]] ValueType Scalar() const
+		{
+			return m_val;
+		}
+
+	private:
+
+		VectorOperand<E> m_lhs;
+		ValueType m_val;
+	};
+
+	//===========================//
+	// expression: scalar op rhs //
+	//===========================//
+
+	template<typename E, typename Op>
+	class ScalarVectorExpression final : public VectorExpression<ScalarVectorExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		ScalarVectorExpression(ValueType val, const E& rhs) : m_val(val), m_rhs(rhs)
+		{
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_rhs.Size();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_val, m_rhs[idx]);
+		}
+
+		[[nodiscard]] ValueType Scalar() const
+		{
+			return m_val;
+		}
+
+		[[nodiscard]] const E& Rhs() const
+		{
+			return m_rhs;
+		}
+
+	private:
+
+		ValueType m_val;
+		VectorOperand<E> m_rhs;
+	};
+
+	//=====================//
+	// expression: op expr //
+	//=====================//
+
+	template<typename E, typename Op>
+	class VectorUnaryExpression final : public VectorExpression<VectorUnaryExpression<E, Op>>
+	{
+	public:
+
+		using ValueType = typename E::ValueType;
+
+		explicit VectorUnaryExpression(const E& expr) : m_expr(expr)
+		{
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_expr.Size();
+		}
+
+		ValueType operator[](size_t idx) const
+		{
+			return Op::Apply(m_expr[idx]);
+		}
+
+	private:
+
+		VectorOperand<E> m_expr;
+	};
+
+	//======================//
+	// arithmetic operators //
+	//======================//
+
+	template<typename L, typename R>
+	auto operator+(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		return VectorBinaryExpression<L, R, OPERATIONS::Plus>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator+(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		return VectorScalarExpression<E, OPERATIONS::Plus>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator+(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return ScalarVectorExpression<E, OPERATIONS::Plus>(val, rhs.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator-(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		return VectorBinaryExpression<L, R, OPERATIONS::Minus>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator-(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		return VectorScalarExpression<E, OPERATIONS::Minus>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator-(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return ScalarVectorExpression<E, OPERATIONS::Minus>(val, rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator-(const VectorExpression<E>& expr)
+	{
+		return VectorUnaryExpression<E, OPERATIONS::Negate>(expr.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator*(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		return VectorBinaryExpression<L, R, OPERATIONS::Multiplies>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator*(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		return VectorScalarExpression<E, OPERATIONS::Multiplies>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator*(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return ScalarVectorExpression<E, OPERATIONS::Multiplies>(val, rhs.Derived());
+	}
+
+	template<typename L, typename R>
+	auto operator/(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		return VectorBinaryExpression<L, R, OPERATIONS::Divides>(lhs.Derived(), rhs.Derived());
+	}
+
+	template<typename E>
+	auto operator/(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		return VectorScalarExpression<E, OPERATIONS::Divides>(lhs.Derived(), val);
+	}
+
+	template<typename E>
+	auto operator/(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return ScalarVectorExpression<E, OPERATIONS::Divides>(val, rhs.Derived());
+	}
+
+	//================//
+	// Check equality //
+	//================//
+
+	template<typename L, typename R>
+	bool operator==(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		const auto& l = lhs.Derived();
+		const auto& r = rhs.Derived();
+		if (l.Size() != r.Size()) return false;
+		for (size_t i = 0; i < l.Size(); i++)
+		{
+			if (l[i] != r[i]) return false;
+		}
+		return true;
+	}
+
+	template<typename E>
+	bool operator==(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		const auto& l = lhs.Derived();
+		for (size_t i = 0; i < l.Size(); i++)
+		{
+			if (l[i] != val) return false;
+		}
+		return true;
+	}
+
+	template<typename E>
+	bool operator==(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return rhs == val;
+	}
+
+	template<typename L, typename R>
+	bool operator!=(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template<typename E>
+	bool operator!=(const VectorExpression<E>& lhs, typename E::ValueType val)
+	{
+		return !(lhs == val);
+	}
+
+	template<typename E>
+	bool operator!=(typename E::ValueType val, const VectorExpression<E>& rhs)
+	{
+		return !(rhs == val);
+	}
+}
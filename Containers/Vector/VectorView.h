@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "VectorExpression.h"
+#include "../Kernels/SimdKernels.h"
+#include "../Kernels/ReductionKernels.h"
+#include "../Kernels/BlasKernels.h"
+
+namespace SEPOLIA4::CONTAINERS
+{
+	template<typename T>
+	class VectorView;
+
+	template<typename E>
+	struct IsVectorView
+	{
+		static constexpr bool value = false;
+	};
+
+	template<typename T>
+	struct IsVectorView<VectorView<T>>
+	{
+		static constexpr bool value = true;
+	};
+
+	//==================================================================//
+	// Non-owning view of the elements data[0], data[stride], ... : a   //
+	// slice of a Vector, or a row, column or diagonal of a Matrix. A   //
+	// view is a vector expression, so it mixes with vectors and other  //
+	// views in the arithmetic, and it has the in-place operations and  //
+	// the reductions of Vector. VectorView<const T> is read-only.      //
+	// Copying a view copies the reference; assigning to a view writes  //
+	// its elements, and the sizes must then match. Contiguous views    //
+	// (stride 1) go to the SIMD kernels, strided ones to scalar loops. //
+	//==================================================================//
+
+	template<typename T>
+	class VectorView final : public VectorExpression<VectorView<T>>
+	{
+	public:
+
+		using ValueType = std::remove_const_t<T>;
+
+		//==============//
+		// Constructors //
+		//==============//
+
+		VectorView() = default;
+
+		VectorView(T* data, size_t size, size_t stride = 1) : m_data(data), m_size(size), m_stride(stride)
+		{
+		}
+
+		template<typename A>
+		VectorView(Vector<ValueType, A>& vec) : VectorView(vec.Data(), vec.Size())
+		{
+		}
+
+		template<typename A, typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+		VectorView(const Vector<ValueType, A>& vec) : VectorView(vec.Data(), vec.Size())
+		{
+		}
+
+		// a writable view converts to a read-only one
+		template<typename U, std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>, int> = 0>
+		VectorView(const VectorView<U>& other) : VectorView(other.Data(), other.Size(), other.Stride())
+		{
+		}
+
+		VectorView(const VectorView& other) = default;
+
+		VectorView& operator=(const VectorView& other)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, other);
+		}
+
+		template<typename E>
+		VectorView& operator=(const VectorExpression<E>& expr)
+		{
+			return Assign(EXECUTION::PAR_UNSEQ, expr);
+		}
+
+		//======================//
+		// Geometry of the view //
+		//======================//
+
+		[[nodiscard]] size_t Size() const
+		{
+			return m_size;
+		}
+
+		// distance, in elements, between consecutive elements of the view
+		[[nodiscard]] size_t Stride() const
+		{
+			return m_stride;
+		}
+
+		[[nodiscard]] bool IsContiguous() const
+		{
+			return m_stride == 1;
+		}
+
+		// the elements of the view are Data()[0], Data()[Stride()], ...
+		[[nodiscard]] T* Data() const
+		{
+			return m_data;
+		}
+
+		// view of size elements of this view, starting at element offset and taking every stride-th one
+		[[nodiscard]] VectorView SubView(size_t offset, size_t size, size_t stride = 1) const
+		{
+			return VectorView(m_data + offset * m_stride, size, stride * m_stride);
+		}
+
+		//======================================//
+		// Operators to access and set elements //
+		//======================================//
+
+		[[nodiscard]] const ValueType& At(size_t idx) const
+		{
+			return m_data[idx * m_stride];
+		}
+
+		T& operator[](size_t idx) const
+		{
+			return m_data[idx * m_stride];
+		}
+
+		//================================================================//
+		// Reductions. Without a policy argument they use PAR_UNSEQ. Min, //
+		// Max, MinMax, ArgMin and ArgMax need a non-empty view.          //
+		//================================================================//
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Sum(Policy policy, Summation summation = Summation::FAST) const
+		{
+			return KERNELS::SumAll(policy, m_data, m_size, summation, m_stride);
+		}
+
+		[[nodiscard]] ValueType Sum(Summation summation = Summation::FAST) const
+		{
+			return Sum(EXECUTION::PAR_UNSEQ, summation);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Dot(Policy policy, VectorView<const ValueType> other) const
+		{
+			if (KERNELS::UseBlas<ValueType>(policy, m_size, KERNELS::BLAS_MIN_LEVEL1_SIZE, m_size, m_stride, other.Stride()))
+			{
+				return KERNELS::BlasDot(m_size, m_data, m_stride, other.Data(), other.Stride());
+			}
+			return KERNELS::DotAll(policy, m_data, other.Data(), m_size, m_stride, other.Stride());
+		}
+
+		[[nodiscard]] ValueType Dot(VectorView<const ValueType> other) const
+		{
+			return Dot(EXECUTION::PAR_UNSEQ, other);
+		}
+
+		// Euclidean norm
+		template<typename Policy>
+		[[nodiscard]] ValueType Norm2(Policy policy) const
+		{
+			return static_cast<ValueType>(std::sqrt(Dot(policy, *this)));
+		}
+
+		[[nodiscard]] ValueType Norm2() const
+		{
+			return Norm2(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Min(Policy policy) const
+		{
+			return KERNELS::ReduceAll<OPERATIONS::Min>(policy, m_data, m_size, m_stride);
+		}
+
+		[[nodiscard]] ValueType Min() const
+		{
+			return Min(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] ValueType Max(Policy policy) const
+		{
+			return KERNELS::ReduceAll<OPERATIONS::Max>(policy, m_data, m_size, m_stride);
+		}
+
+		[[nodiscard]] ValueType Max() const
+		{
+			return Max(EXECUTION::PAR_UNSEQ);
+		}
+
+		template<typename Policy>
+		[[nodiscard]] std::pair<ValueType, ValueType> MinMax(Policy policy) const
+		{
+			return KERNELS::MinMaxAll(policy, m_data, m_size, m_stride);
+		}
+
+		[[nodiscard]] std::pair<ValueType, ValueType> MinMax() const
+		{
+			return MinMax(EXECUTION::PAR_UNSEQ);
+		}
+
+		// index, in the view, of the first smallest element
+		template<typename Policy>
+		[[nodiscard]] size_t ArgMin(Policy policy) const
+		{
+			return KERNELS::ArgReduceAll<OPERATIONS::Min>(policy, m_data, m_size, m_stride);
+		}
+
+		[[nodiscard]] size_t ArgMin() const
+		{
+			return ArgMin(EXECUTION::PAR_UNSEQ);
+		}
+
+		// index, in the view, of the first largest element
+		template<typename Policy>
+		[[nodiscard]] size_t ArgMax(Policy policy) const
+		{
+			return KERNELS::ArgReduceAll<OPERATIONS::Max>(policy, m_data, m_size, m_stride);
+		}
+
+		[[nodiscard]] size_t ArgMax() const
+		{
+			return ArgMax(EXECUTION::PAR_UNSEQ);
+		}
+
+		//=================================================================//
+		// Operations with an execution policy, as for Vector. The right   //
+		// hand side may refer to the viewed elements only index by index: //
+		// it must not read other elements of an overlapping view.         //
+		//=================================================================//
+
+		template<typename Policy, typename E>
+		VectorView& Assign(Policy policy, const VectorExpression<E>& expr)
+		{
+			Evaluate(policy, expr.Derived());
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		VectorView& Add(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Plus>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		VectorView& Add(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Plus>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		VectorView& Subtract(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Minus>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		VectorView& Subtract(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Minus>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		VectorView& Multiply(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Multiplies>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		VectorView& Multiply(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Multiplies>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy, typename E>
+		VectorView& Divide(Policy policy, const VectorExpression<E>& rhs)
+		{
+			CompoundAssign<OPERATIONS::Divides>(policy, rhs.Derived());
+			return *this;
+		}
+
+		template<typename Policy>
+		VectorView& Divide(Policy policy, ValueType val)
+		{
+			CompoundAssignScalar<OPERATIONS::Divides>(policy, val);
+			return *this;
+		}
+
+		template<typename Policy>
+		VectorView& Fill(Policy policy, ValueType val)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			T* const data = m_data;
+			const size_t stride = m_stride;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [data, stride, val](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					data[i * stride] = val;
+				}
+			});
+			return *this;
+		}
+
+		//===============================//
+		// Compound assignment operators //
+		//===============================//
+
+		template<typename E>
+		VectorView& operator+=(const VectorExpression<E>& rhs)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		VectorView& operator+=(ValueType val)
+		{
+			return Add(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		VectorView& operator-=(const VectorExpression<E>& rhs)
+		{
+			return Subtract(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		VectorView& operator-=(ValueType val)
+		{
+			return Subtract(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		VectorView& operator*=(const VectorExpression<E>& rhs)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		VectorView& operator*=(ValueType val)
+		{
+			return Multiply(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		template<typename E>
+		VectorView& operator/=(const VectorExpression<E>& rhs)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, rhs);
+		}
+
+		VectorView& operator/=(ValueType val)
+		{
+			return Divide(EXECUTION::PAR_UNSEQ, val);
+		}
+
+		//============================//
+		// Assignment value operators //
+		//============================//
+
+		VectorView& operator=(ValueType val)
+		{
+			return Fill(EXECUTION::PAR_UNSEQ, val);
+		}
+
+	private:
+
+		// elements of a vector or contiguous view operand, nullptr for anything the kernels cannot read directly
+		template<typename E>
+		static const ValueType* ContiguousData(const E& e)
+		{
+			if constexpr (!std::is_same_v<typename E::ValueType, ValueType>) return nullptr;
+			else if constexpr (IsVectorLeaf<E>::value) return e.Data();
+			else if constexpr (IsVectorView<E>::value) return e.IsContiguous() ? e.Data() : nullptr;
+			else return nullptr;
+		}
+
+		//========================================//
+		// Fused evaluation of an expression tree //
+		//========================================//
+
+		template<typename Policy, typename E>
+		void Evaluate(Policy policy, const E& e)
+		{
+			EvaluateElements(policy, e);
+		}
+
+		template<typename Policy, typename E>
+		void EvaluateElements(Policy policy, const E& e)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			T* const data = m_data;
+			const size_t stride = m_stride;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [data, stride, &e](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					data[i * stride] = e[i];
+				}
+			});
+		}
+
+		// single operations on contiguous operands go to the SIMD kernels
+
+		template<typename Policy, typename L, typename R, typename Op>
+		void Evaluate(Policy policy, const VectorBinaryExpression<L, R, Op>& e)
+		{
+			const ValueType* const a = ContiguousData(e.Lhs());
+			const ValueType* const b = ContiguousData(e.Rhs());
+			if (!IsContiguous() || !a || !b)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			T* const c = m_data;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [policy, a, b, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, a + begin, b + begin, c + begin, end - begin);
+			});
+		}
+
+		template<typename Policy, typename E, typename Op>
+		void Evaluate(Policy policy, const VectorScalarExpression<E, Op>& e)
+		{
+			const ValueType* const a = ContiguousData(e.Lhs());
+			if (!IsContiguous() || !a)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			const ValueType val = e.Scalar();
+			T* const c = m_data;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [policy, a, val, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, a + begin, val, c + begin, end - begin);
+			});
+		}
+
+		template<typename Policy, typename E, typename Op>
+		void Evaluate(Policy policy, const ScalarVectorExpression<E, Op>& e)
+		{
+			const ValueType* const b = ContiguousData(e.Rhs());
+			if (!IsContiguous() || !b)
+			{
+				EvaluateElements(policy, e);
+				return;
+			}
+
+			const ValueType val = e.Scalar();
+			T* const c = m_data;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [policy, val, b, c](size_t begin, size_t end)
+			{
+				KERNELS::Binary<Op>(policy, val, b + begin, c + begin, end - begin);
+			});
+		}
+
+		//======================================//
+		// In-place compound assignment kernels //
+		//======================================//
+
+		template<typename Op, typename Policy, typename E>
+		void CompoundAssign(Policy policy, const E& e)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			T* const c = m_data;
+			const ValueType* const b = ContiguousData(e);
+			if (IsContiguous() && b)
+			{
+				KERNELS::ForChunks<ValueType>(policy, m_size, [policy, b, c](size_t begin, size_t end)
+				{
+					KERNELS::Binary<Op>(policy, c + begin, b + begin, c + begin, end - begin);
+				});
+				return;
+			}
+
+			const size_t stride = m_stride;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [c, stride, &e](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					c[i * stride] = Op::Apply(c[i * stride], e[i]);
+				}
+			});
+		}
+
+		template<typename Op, typename Policy>
+		void CompoundAssignScalar(Policy policy, ValueType val)
+		{
+			static_assert(!std::is_const_v<T>, "the view is read-only");
+			T* const c = m_data;
+			if (IsContiguous())
+			{
+				KERNELS::ForChunks<ValueType>(policy, m_size, [policy, val, c](size_t begin, size_t end)
+				{
+					KERNELS::Binary<Op>(policy, c + begin, val, c + begin, end - begin);
+				});
+				return;
+			}
+
+			const size_t stride = m_stride;
+			KERNELS::ForChunks<ValueType>(policy, m_size, [c, stride, val](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					c[i * stride] = Op::Apply(c[i * stride], val);
+				}
+			});
+		}
+
+		T* m_data = nullptr;
+		size_t m_size = 0;
+		size_t m_stride = 1;
+	};
+}
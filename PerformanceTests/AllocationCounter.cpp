@@ -0,0 +1,84 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	std::atomic<size_t> allocationCount{ 0 };
+}
+
+namespace SEPOLIA4::PERFORMANCE_TESTS
+{
+	size_t GetAllocationCount()
+	{
+		return allocationCount.load(std::memory_order_relaxed);
+	}
+}
+
+void* operator new(size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (size == 0) size = 1;
+	if (void* ptr = std::malloc(size)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	return ::operator new(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	const auto align = static_cast<size_t>(alignment);
+	const size_t roundedSize = (size + align - 1) / align * align;
+	if (void* ptr = std::aligned_alloc(align, roundedSize == 0 ? align : roundedSize)) return ptr;
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return ::operator new(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+	std::free(ptr);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace SEPOLIA4::PERFORMANCE_TESTS
+{
+	//===================================================//
+	// Counts every call to the global operator new made //
+	// by the performance tests executable               //
+	//===================================================//
+
+	size_t GetAllocationCount();
+}
@@ -1,10 +1,22 @@
 #define BOOST_TEST_DYN_LINK
 
 #include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/test/unit_test.hpp>
+#include <cblas.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 #include "../Containers/Matrix/Matrix.h"
+#include "../Containers/Matrix/TiledMatrix.h"
+#include "../Containers/Serialization/BinaryFormat.h"
+#include "../Containers/Vector/Vector.h"
 #include "../Utilities/Clock.h"
+#include "../Utilities/MappedFile.h"
+#include "../Utilities/Parallel.h"
+#include "AllocationCounter.h"
 
 namespace SEPOLIA4::PERFORMANCE_TESTS
 {
@@ -228,6 +240,657 @@ namespace SEPOLIA4::PERFORMANCE_TESTS
 			std::cerr << "tSEP/tUBLAS = " << tSEP / tUBLAS << std::endl;
 		}
 
+		BOOST_AUTO_TEST_CASE(TEST4_CompoundAssignment)
+		{
+			// single-threaded, like UBLAS: the parallel loops allocate their tasks
+			const auto numThreads = GetNumThreads();
+			SetNumThreads(1);
+
+			Clock clock;
+			constexpr uint32_t NROWS = 1001;
+			constexpr uint32_t NCOLS = 999;
+			constexpr size_t DIM = static_cast<size_t>(NROWS) * NCOLS;
+			constexpr int DO_MAX = 20;
+
+			// UBLAS matrices
+			ublas::matrix<double> mUBLAS1(NROWS, NCOLS);
+			ublas::matrix<double> mUBLAS2(NROWS, NCOLS);
+
+			// SEPOLIA containers
+			Matrix<double> mSEP1(NROWS, NCOLS);
+			Matrix<double> mSEP2(NROWS, NCOLS);
+			Vector<double> vSEP1(DIM);
+			Vector<double> vSEP2(DIM);
+
+			for (uint32_t i = 0; i < NROWS; ++i)
+			{
+				for (uint32_t j = 0; j < NCOLS; ++j)
+				{
+					mUBLAS1(i, j) = static_cast<double>(i) + j;
+					mUBLAS2(i, j) = static_cast<double>(j + 1);
+					mSEP1(i, j) = mUBLAS1(i, j);
+					mSEP2(i, j) = mUBLAS2(i, j);
+					vSEP1[static_cast<size_t>(i) * NCOLS + j] = mUBLAS1(i, j);
+					vSEP2[static_cast<size_t>(i) * NCOLS + j] = mUBLAS2(i, j);
+				}
+			}
+
+			// measure the compound assignment operators
+			clock.Reset();
+			auto allocations = GetAllocationCount();
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				mUBLAS1 += mUBLAS2;
+				mUBLAS1 -= mUBLAS2;
+				mUBLAS1 *= 2.0;
+				mUBLAS1 /= 2.0;
+			}
+			const auto allocUBLAS = GetAllocationCount() - allocations;
+			const auto tUBLAS = clock.GetSecondsPassedSinceLastCall();
+
+			allocations = GetAllocationCount();
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				mSEP1 += mSEP2;
+				mSEP1 -= mSEP2;
+				mSEP1 *= 2.0;
+				mSEP1 /= 2.0;
+			}
+			const auto allocSEP = GetAllocationCount() - allocations;
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			allocations = GetAllocationCount();
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				vSEP1 += vSEP2;
+				vSEP1 -= vSEP2;
+				vSEP1 *= vSEP2;
+				vSEP1 /= vSEP2;
+				vSEP1 += 1.0;
+				vSEP1 -= 1.0;
+				vSEP1 *= 2.0;
+				vSEP1 /= 2.0;
+			}
+			const auto allocSEPVector = GetAllocationCount() - allocations;
+			const auto tSEPVector = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			BOOST_CHECK(allocSEP == 0);
+			BOOST_CHECK(allocSEPVector == 0);
+			for (uint32_t i = 0; i < NROWS; i++)
+			{
+				for (uint32_t j = 0; j < NCOLS; j++)
+				{
+					if (mUBLAS1(i, j) != mSEP1(i, j)) BOOST_CHECK(false);
+					if (vSEP1[static_cast<size_t>(i) * NCOLS + j] != mSEP1(i, j)) BOOST_CHECK(false);
+				}
+			}
+
+			// report here
+			std::cout << "Allocations UBLAS = " << allocUBLAS << std::endl;
+			std::cout << "Allocations SEP = " << allocSEP << std::endl;
+			std::cout << "Allocations SEP (vector) = " << allocSEPVector << std::endl;
+			std::cout << "Time used UBLAS = " << tUBLAS << std::endl;
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (vector) = " << tSEPVector << std::endl;
+			std::cerr << "tSEP/tUBLAS = " << tSEP / tUBLAS << std::endl;
+
+			SetNumThreads(numThreads);
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST5_Reductions)
+		{
+			Clock clock;
+			constexpr size_t DIM = 10000019;
+			constexpr int DO_MAX = 10;
+
+			ublas::vector<double> vUBLAS1(DIM);
+			ublas::vector<double> vUBLAS2(DIM);
+			Vector<double> vSEP1(DIM);
+			Vector<double> vSEP2(DIM);
+
+			for (size_t i = 0; i < DIM; i++)
+			{
+				vUBLAS1(i) = static_cast<double>(i % 1000);
+				vUBLAS2(i) = static_cast<double>(i % 100);
+				vSEP1[i] = vUBLAS1(i);
+				vSEP2[i] = vUBLAS2(i);
+			}
+
+			// measure the dot products and sums
+			clock.Reset();
+			double dotUBLAS = 0.0;
+			double sumUBLAS = 0.0;
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				dotUBLAS = ublas::inner_prod(vUBLAS1, vUBLAS2);
+				sumUBLAS = ublas::sum(vUBLAS1);
+			}
+			const auto tUBLAS = clock.GetSecondsPassedSinceLastCall();
+
+			double dotSEP = 0.0;
+			double sumSEP = 0.0;
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				dotSEP = vSEP1.Dot(vSEP2);
+				sumSEP = vSEP1.Sum();
+			}
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			double sumKahan = 0.0;
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				sumKahan = vSEP1.Sum(Summation::KAHAN);
+			}
+			const auto tKahan = clock.GetSecondsPassedSinceLastCall();
+
+			double sumPairwise = 0.0;
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				sumPairwise = vSEP1.Sum(Summation::PAIRWISE);
+			}
+			const auto tPairwise = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			BOOST_CHECK(dotSEP == dotUBLAS);
+			BOOST_CHECK(sumSEP == sumUBLAS);
+			BOOST_CHECK(sumKahan == sumUBLAS);
+			BOOST_CHECK(sumPairwise == sumUBLAS);
+
+			// report here
+			std::cout << "Time used UBLAS = " << tUBLAS << std::endl;
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (Kahan sum) = " << tKahan << std::endl;
+			std::cout << "Time used SEP (pairwise sum) = " << tPairwise << std::endl;
+			std::cerr << "tSEP/tUBLAS = " << tSEP / tUBLAS << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST6_MatMul)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 512;
+			constexpr int DO_MAX = 4;
+
+			Matrix<double> mA(DIM, DIM);
+			Matrix<double> mB(DIM, DIM);
+			Matrix<double> mBLAS(DIM, DIM);
+			Matrix<double> mSEP(DIM, DIM);
+
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mA(i, j) = static_cast<double>((i + j) % 17) * 0.1;
+					mB(i, j) = static_cast<double>((i * j) % 13) * 0.2;
+				}
+			}
+
+			// measure C = A * B
+			clock.Reset();
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, DIM, DIM, DIM,
+						1.0, mA.Data(), DIM, mB.Data(), DIM, 0.0, mBLAS.Data(), DIM);
+			}
+			const auto tBLAS = clock.GetSecondsPassedSinceLastCall();
+
+			// the native kernels: without a policy large products go to BLAS as well
+			for (int kk = 0; kk < DO_MAX; kk++)
+			{
+				Gemm(EXECUTION::UNSEQ, 1.0, mA, mB, 0.0, mSEP);
+			}
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			double maxDiff = 0.0;
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					maxDiff = std::max(maxDiff, std::abs(mSEP(i, j) - mBLAS(i, j)));
+				}
+			}
+			BOOST_CHECK(maxDiff < 1.0e-9);
+
+			// report here
+			const double flops = 2.0 * DIM * DIM * DIM * DO_MAX;
+			std::cout << "Time used BLAS = " << tBLAS << " (" << flops / tBLAS * 1.0e-9 << " GFLOPS)" << std::endl;
+			std::cout << "Time used SEP = " << tSEP << " (" << flops / tSEP * 1.0e-9 << " GFLOPS)" << std::endl;
+			std::cerr << "tSEP/tBLAS = " << tSEP / tBLAS << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST7_Gemv)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 2000;
+			constexpr int DO_MAX = 20;
+
+			Matrix<double> mA(DIM, DIM);
+			Vector<double> vX(DIM);
+			Vector<double> vBLAS(DIM);
+			Vector<double> vSEP(DIM);
+
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mA(i, j) = static_cast<double>((i + 3 * j) % 17) * 0.1;
+				}
+				vX[i] = static_cast<double>(i % 11) - 5.0;
+			}
+
+			for (const auto transpose : { Transpose::NO, Transpose::YES })
+			{
+				// measure y = A * x and y = A^T * x
+				clock.Reset();
+				for (int kk = 0; kk < DO_MAX; kk++)
+				{
+					cblas_dgemv(CblasRowMajor, transpose == Transpose::NO ? CblasNoTrans : CblasTrans, DIM, DIM,
+							1.0, mA.Data(), DIM, vX.Data(), 1, 0.0, vBLAS.Data(), 1);
+				}
+				const auto tBLAS = clock.GetSecondsPassedSinceLastCall();
+
+				// the native kernels: without a policy large products go to BLAS as well
+				for (int kk = 0; kk < DO_MAX; kk++)
+				{
+					Gemv(EXECUTION::UNSEQ, transpose, 1.0, mA, vX, 0.0, vSEP);
+				}
+				const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+				// test here
+				double maxDiff = 0.0;
+				for (uint32_t i = 0; i < DIM; i++)
+				{
+					maxDiff = std::max(maxDiff, std::abs(vSEP[i] - vBLAS[i]));
+				}
+				BOOST_CHECK(maxDiff < 1.0e-9);
+
+				// report here
+				const double flops = 2.0 * DIM * DIM * DO_MAX;
+				std::cout << (transpose == Transpose::NO ? "A * x" : "A^T * x") << std::endl;
+				std::cout << "Time used BLAS = " << tBLAS << " (" << flops / tBLAS * 1.0e-9 << " GFLOPS)" << std::endl;
+				std::cout << "Time used SEP = " << tSEP << " (" << flops / tSEP * 1.0e-9 << " GFLOPS)" << std::endl;
+				std::cerr << "tSEP/tBLAS = " << tSEP / tBLAS << std::endl;
+			}
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST8_GemmScaling)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 1024;
+			const auto numThreads = GetNumThreads();
+			const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+			Matrix<double> mA(DIM, DIM);
+			Matrix<double> mB(DIM, DIM);
+			Matrix<double> mC(DIM, DIM);
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mA(i, j) = static_cast<double>((i + j) % 17) * 0.1;
+					mB(i, j) = static_cast<double>((i * j) % 13) * 0.2;
+				}
+			}
+
+			// the native threaded kernels: BLAS off
+			KERNELS::SetBlasEnabled(false);
+			Matrix<double> mSerial(DIM, DIM);
+			Gemm(EXECUTION::UNSEQ, 1.0, mA, mB, 0.0, mSerial);
+
+			// measure C = A * B on 1, 2, 4, ... and all the cores
+			const double flops = 2.0 * DIM * DIM * DIM;
+			double tOne = 0.0;
+			for (size_t threads = 1; threads <= maxThreads; threads = threads < maxThreads ? std::min(2 * threads, maxThreads) : threads + 1)
+			{
+				SetNumThreads(threads);
+				Gemm(EXECUTION::PAR_UNSEQ, 1.0, mA, mB, 0.0, mC);
+				clock.Reset();
+				Gemm(EXECUTION::PAR_UNSEQ, 1.0, mA, mB, 0.0, mC);
+				const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+				if (threads == 1) tOne = tSEP;
+
+				// test here
+				BOOST_CHECK(mC == mSerial);
+
+				// report here
+				std::cout << "Threads = " << threads << ", time used SEP = " << tSEP << " ("
+						  << flops / tSEP * 1.0e-9 << " GFLOPS)" << std::endl;
+				std::cerr << "speed-up = " << tOne / tSEP << std::endl;
+			}
+
+			KERNELS::SetBlasEnabled(true);
+			SetNumThreads(numThreads);
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST9_Transpose)
+		{
+			Clock clock;
+			constexpr uint32_t DIM1 = 2000;
+			constexpr uint32_t DIM2 = 3000;
+
+			ublas::matrix<double> mUBLAS(DIM1, DIM2);
+			Matrix<double> mSEP(DIM1, DIM2);
+			for (uint32_t i = 0; i < DIM1; i++)
+			{
+				for (uint32_t j = 0; j < DIM2; j++)
+				{
+					mUBLAS(i, j) = static_cast<double>(i * DIM2 + j);
+					mSEP(i, j) = mUBLAS(i, j);
+				}
+			}
+
+			// measure the transposes
+			clock.Reset();
+			const ublas::matrix<double> tUBLASResult = ublas::trans(mUBLAS);
+			const auto tUBLAS = clock.GetSecondsPassedSinceLastCall();
+
+			const Matrix<double> tSEPResult = mSEP.Transposed();
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			// the square block: transposed into existing storage, then back in place
+			Matrix<double> mSquare(DIM1, DIM1);
+			clock.Reset();
+			CopyTransposed<double>(mSEP.Block(0, 0, DIM1, DIM1), mSquare);
+			const auto tSEPCopy = clock.GetSecondsPassedSinceLastCall();
+
+			mSquare.TransposeInPlace();
+			const auto tSEPSquare = clock.GetSecondsPassedSinceLastCall();
+
+			mSEP.TransposeInPlace();
+			const auto tSEPRectangular = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			bool same = true;
+			for (uint32_t i = 0; i < DIM2; i++)
+			{
+				for (uint32_t j = 0; j < DIM1; j++)
+				{
+					same = same && tSEPResult.At(i, j) == tUBLASResult(i, j) && mSEP.At(i, j) == tUBLASResult(i, j);
+					same = same && (i >= DIM1 || mSquare.At(j, i) == tUBLASResult(i, j));
+				}
+			}
+			BOOST_CHECK(same);
+
+			// report here
+			std::cout << "Time used UBLAS = " << tUBLAS << std::endl;
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (into existing storage) = " << tSEPCopy << std::endl;
+			std::cout << "Time used SEP (in place, square) = " << tSEPSquare << std::endl;
+			std::cout << "Time used SEP (in place, rectangular) = " << tSEPRectangular << std::endl;
+			std::cerr << "tSEP/tUBLAS = " << tSEP / tUBLAS << std::endl;
+		}
+
+		BOOST_AUTO_TEST_CASE(TEST10_StorageOrder)
+		{
+			Clock clock;
+			constexpr uint32_t DIM1 = 2000;
+			constexpr uint32_t DIM2 = 3000;
+
+			ublas::matrix<double> mUBLAS(DIM1, DIM2);
+			Matrix<double> mSEP(DIM1, DIM2);
+			for (uint32_t i = 0; i < DIM1; i++)
+			{
+				for (uint32_t j = 0; j < DIM2; j++)
+				{
+					mUBLAS(i, j) = static_cast<double>(i * DIM2 + j);
+					mSEP(i, j) = mUBLAS(i, j);
+				}
+			}
+
+			// measure the conversions to column-major storage
+			clock.Reset();
+			const ublas::matrix<double, ublas::column_major> cUBLASResult = mUBLAS;
+			const auto tUBLAS = clock.GetSecondsPassedSinceLastCall();
+
+			const ColumnMajorMatrix<double> cSEPResult = mSEP;
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			const ColumnMajorMatrix<double> cSEPMoved = std::move(mSEP);
+			const auto tSEPMove = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			bool same = true;
+			for (uint32_t i = 0; i < DIM1; i++)
+			{
+				for (uint32_t j = 0; j < DIM2; j++)
+				{
+					same = same && cSEPResult.At(i, j) == cUBLASResult(i, j) && cSEPMoved.At(i, j) == cUBLASResult(i, j);
+				}
+			}
+			same = same && cSEPResult.Data()[1] == cUBLASResult.data()[1];
+			BOOST_CHECK(same);
+
+			// report here
+			std::cout << "Time used UBLAS = " << tUBLAS << std::endl;
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (move) = " << tSEPMove << std::endl;
+			std::cerr << "tSEP/tUBLAS = " << tSEP / tUBLAS << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST11_PaddedColumnWalk)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 4096;
+
+			Matrix<float> mSEP(DIM, DIM);
+			Matrix<float> mPadded(DIM, DIM, PADDED);
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mSEP(i, j) = static_cast<float>((i + j) % 7);
+				}
+			}
+			mPadded = mSEP;
+
+			// walk the columns: the rows of mSEP are 16 KiB apart and fall into the same cache sets
+			const auto columnSums = [](const Matrix<float>& m)
+			{
+				std::vector<double> sums(DIM, 0.0);
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					for (uint32_t i = 0; i < DIM; i++)
+					{
+						sums[j] += m.At(i, j);
+					}
+				}
+				return sums;
+			};
+
+			clock.Reset();
+			const auto sSEP = columnSums(mSEP);
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			const auto sPadded = columnSums(mPadded);
+			const auto tPadded = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			BOOST_CHECK(sSEP == sPadded);
+			BOOST_CHECK(mPadded.LeadingDimension() == PaddedLeadingDimension<float>(DIM));
+
+			// report here
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (padded) = " << tPadded << std::endl;
+			std::cerr << "tPadded/tSEP = " << tPadded / tSEP << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST12_Tiled)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 4096;
+			constexpr uint32_t TILE = 32;
+
+			Matrix<float> mSEP(DIM, DIM);
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mSEP(i, j) = static_cast<float>((i + j) % 7);
+				}
+			}
+
+			clock.Reset();
+			TiledMatrix<float, TILE> mTiled(mSEP);
+			const auto tPack = clock.GetSecondsPassedSinceLastCall();
+			Matrix<float> mBack = mTiled.ToMatrix();
+			const auto tUnpack = clock.GetSecondsPassedSinceLastCall();
+
+			// walk the blocks down the block columns: a block of mSEP spans TILE rows 16 KiB apart
+			std::vector<double> sSEP;
+			std::vector<double> sTiled;
+			sSEP.reserve((DIM / TILE) * (DIM / TILE));
+			sTiled.reserve((DIM / TILE) * (DIM / TILE));
+
+			clock.Reset();
+			for (uint32_t tj = 0; tj < DIM / TILE; tj++)
+			{
+				for (uint32_t ti = 0; ti < DIM / TILE; ti++)
+				{
+					sSEP.push_back(mSEP.Block(ti * TILE, tj * TILE, TILE, TILE).Sum());
+				}
+			}
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			const auto& cTiled = mTiled;
+			for (uint32_t tj = 0; tj < DIM / TILE; tj++)
+			{
+				for (uint32_t ti = 0; ti < DIM / TILE; ti++)
+				{
+					sTiled.push_back(cTiled.Tile(ti, tj).Sum());
+				}
+			}
+			const auto tTiled = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			BOOST_CHECK(mBack == mSEP);
+			BOOST_CHECK(sSEP == sTiled);
+
+			// report here
+			std::cout << "Time used SEP (pack) = " << tPack << std::endl;
+			std::cout << "Time used SEP (unpack) = " << tUnpack << std::endl;
+			std::cout << "Time used SEP = " << tSEP << std::endl;
+			std::cout << "Time used SEP (tiled) = " << tTiled << std::endl;
+			std::cerr << "tTiled/tSEP = " << tTiled / tSEP << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST13_MappedMatrix)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 4096;
+			const std::string path = (std::filesystem::temp_directory_path() / "sepolia4_perf_test13.bin").string();
+
+			{
+				Matrix<double> mFile(DIM, DIM, std::make_shared<MappedFile>(path, sizeof(double) * DIM * DIM));
+				mFile = 1.5;
+				mFile.GetMappedFile()->Sync();
+			}
+
+			// read the file into allocated storage, then sum
+			clock.Reset();
+			Matrix<double> mSEP(DIM, DIM, UNINITIALIZED);
+			{
+				std::ifstream stream(path, std::ios::binary);
+				stream.read(reinterpret_cast<char*>(mSEP.Data()), static_cast<std::streamsize>(sizeof(double) * DIM * DIM));
+			}
+			const double sSEP = mSEP.Sum();
+			const auto tSEP = clock.GetSecondsPassedSinceLastCall();
+
+			// map the file and sum in place: the pages come from the page cache without a copy
+			const auto file = std::make_shared<MappedFile>(path, MapMode::COPY_ON_WRITE);
+			file->Advise(AccessPattern::SEQUENTIAL);
+			const Matrix<double> mMapped(DIM, DIM, file);
+			const double sMapped = mMapped.Sum();
+			const auto tMapped = clock.GetSecondsPassedSinceLastCall();
+
+			std::filesystem::remove(path);
+
+			// test here
+			BOOST_CHECK(sSEP == 1.5 * DIM * DIM);
+			BOOST_CHECK(sMapped == sSEP);
+
+			// report here
+			std::cout << "Time used SEP (read) = " << tSEP << std::endl;
+			std::cout << "Time used SEP (mapped) = " << tMapped << std::endl;
+			std::cerr << "tMapped/tSEP = " << tMapped / tSEP << std::endl;
+		}
+
+
+		BOOST_AUTO_TEST_CASE(TEST14_BinaryFormat)
+		{
+			Clock clock;
+			constexpr uint32_t DIM = 2048;
+			const std::string textPath = (std::filesystem::temp_directory_path() / "sepolia4_perf_test14.txt").string();
+			const std::string binaryPath = (std::filesystem::temp_directory_path() / "sepolia4_perf_test14.bin").string();
+
+			Matrix<double> mSEP(DIM, DIM);
+			for (uint32_t i = 0; i < DIM; i++)
+			{
+				for (uint32_t j = 0; j < DIM; j++)
+				{
+					mSEP(i, j) = static_cast<double>(i) / (j + 1);
+				}
+			}
+
+			// text through streams, as the checkpoints were written so far
+			clock.Reset();
+			{
+				std::ofstream stream(textPath);
+				stream.precision(17);
+				for (uint32_t i = 0; i < DIM; i++)
+				{
+					for (uint32_t j = 0; j < DIM; j++)
+					{
+						stream << mSEP.At(i, j) << ' ';
+					}
+					stream << '\n';
+				}
+			}
+			Matrix<double> mText(DIM, DIM, UNINITIALIZED);
+			{
+				std::ifstream stream(textPath);
+				for (uint32_t i = 0; i < DIM; i++)
+				{
+					for (uint32_t j = 0; j < DIM; j++)
+					{
+						stream >> mText(i, j);
+					}
+				}
+			}
+			const auto tText = clock.GetSecondsPassedSinceLastCall();
+
+			SERIALIZATION::Save(binaryPath, mSEP);
+			const auto tSave = clock.GetSecondsPassedSinceLastCall();
+			const Matrix<double> mLoaded = SERIALIZATION::LoadMatrix<double>(binaryPath);
+			const auto tLoad = clock.GetSecondsPassedSinceLastCall();
+			const Matrix<double> mMapped = SERIALIZATION::MapMatrix<double>(binaryPath);
+			const auto tMap = clock.GetSecondsPassedSinceLastCall();
+
+			// test here
+			BOOST_CHECK(mText == mSEP);
+			BOOST_CHECK(mLoaded == mSEP);
+			BOOST_CHECK(mMapped == mSEP);
+			BOOST_CHECK(std::filesystem::file_size(binaryPath) < std::filesystem::file_size(textPath));
+
+			std::filesystem::remove(textPath);
+			std::filesystem::remove(binaryPath);
+
+			// report here
+			std::cout << "Time used text (write + read) = " << tText << std::endl;
+			std::cout << "Time used SEP (save) = " << tSave << std::endl;
+			std::cout << "Time used SEP (load) = " << tLoad << std::endl;
+			std::cout << "Time used SEP (map) = " << tMap << std::endl;
+			std::cerr << "(tSave + tLoad)/tText = " << (tSave + tLoad) / tText << std::endl;
+		}
+
+
 	BOOST_AUTO_TEST_SUITE_END()
 }
 
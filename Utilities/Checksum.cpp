@@ -0,0 +1,143 @@
+#include "Checksum.h"
+#include <cstring>
+
+namespace SEPOLIA4::UTILITIES
+{
+	namespace
+	{
+		constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+		constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+		constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+		constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+		constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+		inline uint64_t RotateLeft(uint64_t x, int bits)
+		{
+			return (x << bits) | (x >> (64 - bits));
+		}
+
+		// the format is little-endian, as the machines we run on
+		inline uint64_t Read64(const unsigned char* ptr)
+		{
+			uint64_t val;
+			std::memcpy(&val, ptr, sizeof(val));
+			return val;
+		}
+
+		inline uint32_t Read32(const unsigned char* ptr)
+		{
+			uint32_t val;
+			std::memcpy(&val, ptr, sizeof(val));
+			return val;
+		}
+
+		inline uint64_t Round(uint64_t acc, uint64_t input)
+		{
+			acc += input * PRIME2;
+			acc = RotateLeft(acc, 31);
+			return acc * PRIME1;
+		}
+
+		inline uint64_t MergeRound(uint64_t acc, uint64_t lane)
+		{
+			acc ^= Round(0, lane);
+			return acc * PRIME1 + PRIME4;
+		}
+
+		inline void ConsumeStripe(uint64_t* lanes, const unsigned char* ptr)
+		{
+			lanes[0] = Round(lanes[0], Read64(ptr));
+			lanes[1] = Round(lanes[1], Read64(ptr + 8));
+			lanes[2] = Round(lanes[2], Read64(ptr + 16));
+			lanes[3] = Round(lanes[3], Read64(ptr + 24));
+		}
+	}
+
+	Checksum64::Checksum64(uint64_t seed) :
+			m_seed(seed),
+			m_lanes{ seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 },
+			m_buffer{}
+	{
+	}
+
+	void Checksum64::Update(const void* data, size_t bytes)
+	{
+		const auto* ptr = static_cast<const unsigned char*>(data);
+		m_totalBytes += bytes;
+
+		// complete the stripe left over from the previous call
+		if (m_bufferedBytes > 0)
+		{
+			const size_t n = bytes < 32 - m_bufferedBytes ? bytes : 32 - m_bufferedBytes;
+			std::memcpy(m_buffer + m_bufferedBytes, ptr, n);
+			m_bufferedBytes += n;
+			ptr += n;
+			bytes -= n;
+			if (m_bufferedBytes < 32) return;
+			ConsumeStripe(m_lanes, m_buffer);
+			m_bufferedBytes = 0;
+		}
+
+		uint64_t lanes[4] = { m_lanes[0], m_lanes[1], m_lanes[2], m_lanes[3] };
+		for (; bytes >= 32; ptr += 32, bytes -= 32)
+		{
+			ConsumeStripe(lanes, ptr);
+		}
+		std::memcpy(m_lanes, lanes, sizeof(lanes));
+
+		std::memcpy(m_buffer, ptr, bytes);
+		m_bufferedBytes = bytes;
+	}
+
+	uint64_t Checksum64::Digest() const
+	{
+		uint64_t hash;
+		if (m_totalBytes >= 32)
+		{
+			hash = RotateLeft(m_lanes[0], 1) + RotateLeft(m_lanes[1], 7) + RotateLeft(m_lanes[2], 12) + RotateLeft(m_lanes[3], 18);
+			for (const uint64_t lane : m_lanes)
+			{
+				hash = MergeRound(hash, lane);
+			}
+		}
+		else
+		{
+			hash = m_seed + PRIME5;
+		}
+		hash += m_totalBytes;
+
+		const unsigned char* ptr = m_buffer;
+		size_t bytes = m_bufferedBytes;
+		for (; bytes >= 8; ptr += 8, bytes -= 8)
+		{
+			hash ^= Round(0, Read64(ptr));
+			hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+		}
+		if (bytes >= 4)
+		{
+			hash ^= static_cast<uint64_t>(Read32(ptr)) * PRIME1;
+			hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+			ptr += 4;
+			bytes -= 4;
+		}
+		for (; bytes > 0; ptr++, bytes--)
+		{
+			hash ^= *ptr * PRIME5;
+			hash = RotateLeft(hash, 11) * PRIME1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= PRIME2;
+		hash ^= hash >> 29;
+		hash *= PRIME3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+
+	uint64_t Checksum64::Compute(const void* data, size_t bytes, uint64_t seed)
+	{
+		Checksum64 checksum(seed);
+		checksum.Update(data, bytes);
+		return checksum.Digest();
+	}
+}
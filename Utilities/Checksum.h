@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SEPOLIA4::UTILITIES
+{
+	//===================================================================//
+	// Streaming 64-bit XXH64 checksum: the bytes may be fed in pieces   //
+	// of any size, the digest only depends on their concatenation and   //
+	// matches the reference implementation (xxhsum -H64). It runs four  //
+	// independent lanes over 32-byte stripes, close to memory bandwidth //
+	// on large buffers, and catches truncated or corrupted data, not    //
+	// deliberate tampering.                                             //
+	//===================================================================//
+
+	class Checksum64 final
+	{
+	public:
+
+		explicit Checksum64(uint64_t seed = 0);
+
+		void Update(const void* data, size_t bytes);
+
+		// checksum of the bytes fed so far; more bytes may follow
+		[[nodiscard]] uint64_t Digest() const;
+
+		[[nodiscard]] static uint64_t Compute(const void* data, size_t bytes, uint64_t seed = 0);
+
+	private:
+
+		uint64_t m_seed;
+		uint64_t m_lanes[4];
+		uint64_t m_totalBytes = 0;
+		unsigned char m_buffer[32];
+		size_t m_bufferedBytes = 0;
+	};
+}
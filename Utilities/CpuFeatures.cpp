@@ -0,0 +1,86 @@
+#include "CpuFeatures.h"
+#include <atomic>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace SEPOLIA4::UTILITIES
+{
+	namespace
+	{
+		SimdLevel DetectSimdLevel()
+		{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::AVX2;
+			if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+#endif
+			return SimdLevel::SCALAR;
+		}
+
+		std::atomic<SimdLevel>& ActiveSimdLevel()
+		{
+			static std::atomic<SimdLevel> level{ CpuFeatures::GetDetectedSimdLevel() };
+			return level;
+		}
+
+		size_t DetectCacheSize(int level)
+		{
+			long size = 0;
+#if defined(__linux__) && defined(_SC_LEVEL1_DCACHE_SIZE)
+			if (level == 1) size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+			else if (level == 2) size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+			else if (level == 3) size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+			if (size > 0) return static_cast<size_t>(size);
+			if (level == 1) return size_t(32) << 10;
+			if (level == 2) return size_t(1) << 20;
+			return size_t(8) << 20;
+		}
+
+		// forces the detection when the program starts
+		const SimdLevel startupSimdLevel = CpuFeatures::GetSimdLevel();
+	}
+
+	SimdLevel CpuFeatures::GetDetectedSimdLevel()
+	{
+		static const SimdLevel detected = DetectSimdLevel();
+		return detected;
+	}
+
+	SimdLevel CpuFeatures::GetSimdLevel()
+	{
+		return ActiveSimdLevel().load(std::memory_order_relaxed);
+	}
+
+	void CpuFeatures::SetSimdLevel(SimdLevel level)
+	{
+		const auto detected = GetDetectedSimdLevel();
+		ActiveSimdLevel().store(level < detected ? level : detected, std::memory_order_relaxed);
+	}
+
+	const char* CpuFeatures::ToString(SimdLevel level)
+	{
+		switch (level)
+		{
+			case SimdLevel::SSE2:
+				return "SSE2";
+			case SimdLevel::AVX2:
+				return "AVX2";
+			case SimdLevel::AVX512:
+				return "AVX512";
+			default:
+				return "SCALAR";
+		}
+	}
+
+	size_t CpuFeatures::GetCacheSize(int level)
+	{
+		static const size_t sizes[3] = { DetectCacheSize(1), DetectCacheSize(2), DetectCacheSize(3) };
+		if (level < 1) level = 1;
+		if (level > 3) level = 3;
+		return sizes[level - 1];
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace SEPOLIA4::UTILITIES
+{
+	enum class SimdLevel
+	{
+		SCALAR = 0,
+		SSE2 = 1,
+		AVX2 = 2,   // with FMA
+
+		AVX512 = 3
+	};
+
+	class CpuFeatures final
+	{
+	public:
+
+		CpuFeatures() = delete;
+
+		// widest instruction set supported by the CPU we run on (detected once, at startup)
+		[[nodiscard]] static SimdLevel GetDetectedSimdLevel();
+
+		// instruction set the container kernels dispatch to
+		[[nodiscard]] static SimdLevel GetSimdLevel();
+
+		// restricts the dispatch to a narrower instruction set (it is clamped to the detected one)
+		static void SetSimdLevel(SimdLevel level);
+
+		[[nodiscard]] static const char* ToString(SimdLevel level);
+
+		// size in bytes of the level 1 (data), 2 or 3 cache of the CPU we run on, or a typical size when unknown
+		[[nodiscard]] static size_t GetCacheSize(int level);
+	};
+}
@@ -0,0 +1,138 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SEPOLIA4::UTILITIES
+{
+	namespace
+	{
+		[[noreturn]] void ThrowSystemError(const std::string& what, const std::string& path)
+		{
+			throw std::system_error(errno, std::generic_category(), "MappedFile: " + what + " " + path);
+		}
+
+		int ToAdvice(AccessPattern pattern)
+		{
+			switch (pattern)
+			{
+			case AccessPattern::SEQUENTIAL:
+				return MADV_SEQUENTIAL;
+			case AccessPattern::RANDOM:
+				return MADV_RANDOM;
+			case AccessPattern::WILL_NEED:
+				return MADV_WILLNEED;
+			case AccessPattern::DONT_NEED:
+				return MADV_DONTNEED;
+			default:
+				return MADV_NORMAL;
+			}
+		}
+
+		// closes the descriptor on every path: the mapping does not need it
+		class FileDescriptor final
+		{
+		public:
+
+			explicit FileDescriptor(int fd) : m_fd(fd)
+			{
+			}
+
+			FileDescriptor(const FileDescriptor&) = delete;
+
+			FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+			~FileDescriptor()
+			{
+				if (m_fd >= 0) close(m_fd);
+			}
+
+			[[nodiscard]] int Get() const
+			{
+				return m_fd;
+			}
+
+		private:
+
+			int m_fd;
+		};
+	}
+
+	MappedFile::MappedFile(const std::string& path, MapMode mode) : m_path(path), m_mode(mode)
+	{
+		const FileDescriptor fd(open(path.c_str(), mode == MapMode::READ_WRITE ? O_RDWR : O_RDONLY));
+		if (fd.Get() < 0) ThrowSystemError("cannot open", path);
+
+		struct stat status{};
+		if (fstat(fd.Get(), &status) != 0) ThrowSystemError("cannot stat", path);
+		Map(fd.Get(), static_cast<size_t>(status.st_size));
+	}
+
+	MappedFile::MappedFile(const std::string& path, size_t size) : m_path(path), m_mode(MapMode::READ_WRITE)
+	{
+		const FileDescriptor fd(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+		if (fd.Get() < 0) ThrowSystemError("cannot create", path);
+
+		// the file is sparse: its blocks are allocated as the pages are written
+		if (ftruncate(fd.Get(), static_cast<off_t>(size)) != 0) ThrowSystemError("cannot resize", path);
+		Map(fd.Get(), size);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (m_data) munmap(m_data, m_size);
+	}
+
+	char* MappedFile::Data() const
+	{
+		return m_data;
+	}
+
+	size_t MappedFile::Size() const
+	{
+		return m_size;
+	}
+
+	MapMode MappedFile::GetMode() const
+	{
+		return m_mode;
+	}
+
+	const std::string& MappedFile::GetPath() const
+	{
+		return m_path;
+	}
+
+	void MappedFile::Advise(AccessPattern pattern, size_t offset, size_t length) const
+	{
+		if (!m_data || offset >= m_size) return;
+		const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		const size_t begin = offset / pageSize * pageSize;
+		const size_t end = std::min(m_size, offset + std::min(length, m_size - offset));
+		// the hint is best effort: a refused one changes nothing but the paging
+		madvise(m_data + begin, end - begin, ToAdvice(pattern));
+	}
+
+	void MappedFile::Sync() const
+	{
+		if (!m_data || m_mode != MapMode::READ_WRITE) return;
+		if (msync(m_data, m_size, MS_SYNC) != 0) ThrowSystemError("cannot sync", m_path);
+	}
+
+	void MappedFile::Map(int fd, size_t size)
+	{
+		// mmap refuses empty mappings: an empty file maps to no memory
+		if (size == 0) return;
+		const int protection = m_mode == MapMode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+		const int flags = m_mode == MapMode::COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED;
+		void* data = mmap(nullptr, size, protection, flags, fd, 0);
+		if (data == MAP_FAILED) ThrowSystemError("cannot map", m_path);
+		m_data = static_cast<char*>(data);
+		m_size = size;
+	}
+}
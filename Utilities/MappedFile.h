@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <string>
+
+namespace SEPOLIA4::UTILITIES
+{
+	enum class MapMode
+	{
+		READ_ONLY,     // writes to the mapping fault
+		COPY_ON_WRITE, // writes go to private copies of the pages, the file is left untouched
+		READ_WRITE     // writes go to the file, and are seen by every process that maps it
+	};
+
+	enum class AccessPattern
+	{
+		NORMAL,
+		SEQUENTIAL, // aggressive read-ahead, the pages read may be dropped soon after
+		RANDOM,     // no read-ahead
+		WILL_NEED,  // the pages are read in now, in the background
+		DONT_NEED   // the pages may be dropped: they are read again from the file (private copies are lost)
+	};
+
+	//===================================================================//
+	// A whole file mapped into memory with mmap, so that containers     //
+	// built on it (see the Matrix and Vector constructors taking one)   //
+	// work on data larger than RAM, paged in on demand and written back //
+	// by the kernel, and processes mapping the same file share a single //
+	// copy in the page cache. The mapping starts on a page boundary.    //
+	// Failures to open, create or map the file throw std::system_error. //
+	//===================================================================//
+
+	class MappedFile final
+	{
+	public:
+
+		// maps the existing file at path
+		MappedFile(const std::string& path, MapMode mode);
+
+		// creates the file at path (truncating an existing one) with size zero bytes and maps it READ_WRITE
+		MappedFile(const std::string& path, size_t size);
+
+		MappedFile(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&&) = delete;
+
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile& operator=(MappedFile&&) = delete;
+
+		// unmaps the file: pages written through a READ_WRITE mapping reach the file in any case
+		~MappedFile();
+
+		[[nodiscard]] char* Data() const;
+
+		// in bytes
+		[[nodiscard]] size_t Size() const;
+
+		[[nodiscard]] MapMode GetMode() const;
+
+		[[nodiscard]] const std::string& GetPath() const;
+
+		// madvise hint for the bytes [offset, offset + length), clipped to the file and extended to whole pages
+		void Advise(AccessPattern pattern, size_t offset = 0, size_t length = std::numeric_limits<size_t>::max()) const;
+
+		// writes the modified pages of a READ_WRITE mapping back to the file and waits for the writes
+		void Sync() const;
+
+	private:
+
+		void Map(int fd, size_t size);
+
+		std::string m_path;
+		char* m_data = nullptr;
+		size_t m_size = 0;
+		MapMode m_mode = MapMode::READ_ONLY;
+	};
+}
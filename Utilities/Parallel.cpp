@@ -0,0 +1,100 @@
+#include "Parallel.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace SEPOLIA4::UTILITIES
+{
+	namespace
+	{
+		std::atomic<size_t>& NumThreads()
+		{
+			static std::atomic<size_t> numThreads{ std::max<size_t>(1, std::thread::hardware_concurrency()) };
+			return numThreads;
+		}
+
+		std::atomic<bool>& ThreadPinning()
+		{
+			static std::atomic<bool> pinThreads{ false };
+			return pinThreads;
+		}
+
+		// the pool matching the current settings: callers keep it alive while they use it
+		std::shared_ptr<ThreadPool> GetThreadPool()
+		{
+			static std::mutex mutex;
+			static std::shared_ptr<ThreadPool> pool;
+
+			const size_t numWorkers = GetNumThreads() - 1;
+			const bool pinThreads = GetThreadPinning();
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!pool || pool->GetNumWorkers() != numWorkers || pool->IsPinned() != pinThreads)
+			{
+				pool.reset();
+				pool = std::make_shared<ThreadPool>(numWorkers, pinThreads);
+			}
+			return pool;
+		}
+	}
+
+	ChunkRange StaticPartition(size_t n, size_t numChunks, size_t chunkIdx, size_t blockSize)
+	{
+		blockSize = std::max<size_t>(1, blockSize);
+		numChunks = std::max<size_t>(1, numChunks);
+		const size_t numBlocks = (n + blockSize - 1) / blockSize;
+		const size_t blocksPerChunk = numBlocks / numChunks;
+		const size_t remainder = numBlocks % numChunks;
+
+		// the first 'remainder' chunks get one extra block
+		const size_t firstBlock = chunkIdx * blocksPerChunk + std::min(chunkIdx, remainder);
+		const size_t lastBlock = firstBlock + blocksPerChunk + (chunkIdx < remainder ? 1 : 0);
+
+		ChunkRange range;
+		range.begin = std::min(n, firstBlock * blockSize);
+		range.end = std::min(n, lastBlock * blockSize);
+		return range;
+	}
+
+	size_t GetNumThreads()
+	{
+		return NumThreads().load(std::memory_order_relaxed);
+	}
+
+	void SetNumThreads(size_t numThreads)
+	{
+		NumThreads().store(std::max<size_t>(1, numThreads), std::memory_order_relaxed);
+	}
+
+	bool GetThreadPinning()
+	{
+		return ThreadPinning().load(std::memory_order_relaxed);
+	}
+
+	void SetThreadPinning(bool pinThreads)
+	{
+		ThreadPinning().store(pinThreads, std::memory_order_relaxed);
+	}
+
+	void ParallelFor(size_t n, size_t blockSize, const std::function<void(size_t, size_t)>& body)
+	{
+		ParallelForChunks(n, GetNumThreads(), blockSize, [&body](size_t, size_t begin, size_t end)
+		{
+			body(begin, end);
+		});
+	}
+
+	void ParallelForChunks(size_t n, size_t numChunks, size_t blockSize, const std::function<void(size_t, size_t, size_t)>& body)
+	{
+		numChunks = std::max<size_t>(1, numChunks);
+		if (numChunks == 1 || n <= blockSize)
+		{
+			if (n > 0) body(0, 0, n);
+			return;
+		}
+
+		GetThreadPool()->ParallelFor(n, numChunks, blockSize, body);
+	}
+}
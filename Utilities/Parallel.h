@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace SEPOLIA4::UTILITIES
+{
+	struct ChunkRange
+	{
+		size_t begin = 0;
+		size_t end = 0;
+	};
+
+	//====================================================================//
+	// Static partition of [0, n) into numChunks contiguous ranges whose  //
+	// inner boundaries are multiples of blockSize. Every parallel kernel //
+	// and the parallel first-touch initialization use this partition,    //
+	// so chunk k of a container is always handled by the same worker.    //
+	//====================================================================//
+
+	ChunkRange StaticPartition(size_t n, size_t numChunks, size_t chunkIdx, size_t blockSize = 1);
+
+	//==================================================================//
+	// ParallelFor runs on a process-wide ThreadPool of GetNumThreads() //
+	// - 1 persistent workers plus the calling thread. The pool is      //
+	// rebuilt on the next loop after the thread count or the pinning   //
+	// changes; do not change them while parallel loops are running.    //
+	//==================================================================//
+
+	// number of threads used by ParallelFor (defaults to the hardware concurrency)
+	size_t GetNumThreads();
+
+	void SetNumThreads(size_t numThreads);
+
+	// whether the workers are bound to one CPU each (off by default)
+	bool GetThreadPinning();
+
+	void SetThreadPinning(bool pinThreads);
+
+	// runs body(begin, end) on every chunk of the static partition of [0, n), one chunk per thread
+	void ParallelFor(size_t n, size_t blockSize, const std::function<void(size_t, size_t)>& body);
+
+	// runs body(chunkIdx, begin, end) on every non-empty chunk of the static partition of [0, n) into numChunks chunks
+	void ParallelForChunks(size_t n, size_t numChunks, size_t blockSize, const std::function<void(size_t, size_t, size_t)>& body);
+}
@@ -0,0 +1,247 @@
+#include "ThreadPool.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SEPOLIA4::UTILITIES
+{
+	namespace
+	{
+		// pool and index of the worker running on this thread, if any
+		thread_local const ThreadPool* currentPool = nullptr;
+		thread_local size_t currentWorkerIdx = 0;
+
+		void PinThread(std::thread& thread, size_t cpuIdx)
+		{
+#ifdef __linux__
+			const size_t numCpus = std::max<size_t>(1, std::thread::hardware_concurrency());
+			cpu_set_t cpuSet;
+			CPU_ZERO(&cpuSet);
+			CPU_SET(cpuIdx % numCpus, &cpuSet);
+			pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+			(void) thread;
+			(void) cpuIdx;
+#endif
+		}
+	}
+
+	ThreadPool::ThreadPool(size_t numWorkers, bool pinThreads) : m_pinned(pinThreads)
+	{
+		m_workers.reserve(numWorkers);
+		for (size_t i = 0; i < numWorkers; i++)
+		{
+			m_workers.push_back(std::make_unique<Worker>());
+		}
+
+		// the deques must all exist before any worker starts stealing
+		for (size_t i = 0; i < numWorkers; i++)
+		{
+			m_workers[i]->thread = std::thread(&ThreadPool::Run, this, i);
+			if (pinThreads) PinThread(m_workers[i]->thread, i + 1);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_signal.notify_all();
+
+		for (auto& worker: m_workers)
+		{
+			worker->thread.join();
+		}
+	}
+
+	size_t ThreadPool::GetNumWorkers() const
+	{
+		return m_workers.size();
+	}
+
+	bool ThreadPool::IsPinned() const
+	{
+		return m_pinned;
+	}
+
+	void ThreadPool::Submit(size_t workerIdx, std::function<void()> task)
+	{
+		if (m_workers.empty())
+		{
+			task();
+			return;
+		}
+
+		auto& worker = *m_workers[workerIdx % m_workers.size()];
+		{
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			worker.tasks.push_back(std::move(task));
+			m_numPending++;
+		}
+		NotifyAll();
+	}
+
+	bool ThreadPool::RunPendingTask()
+	{
+		std::function<void()> task;
+		const bool isWorker = currentPool == this;
+		if ((isWorker && PopTask(currentWorkerIdx, task)) ||
+			StealTask(isWorker ? currentWorkerIdx : m_workers.size(), task))
+		{
+			task();
+			return true;
+		}
+		return false;
+	}
+
+	void ThreadPool::ParallelFor(size_t n, size_t numChunks, size_t blockSize, const std::function<void(size_t, size_t, size_t)>& body)
+	{
+		numChunks = std::max<size_t>(1, numChunks);
+		if (n == 0) return;
+		if (numChunks == 1)
+		{
+			body(0, 0, n);
+			return;
+		}
+
+		struct TaskGroup
+		{
+			std::atomic<size_t> remaining{ 0 };
+			std::mutex mutex;
+			std::exception_ptr error;
+		} group;
+
+		const auto runChunk = [&group, &body](size_t chunkIdx, ChunkRange range)
+		{
+			try
+			{
+				body(chunkIdx, range.begin, range.end);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(group.mutex);
+				if (!group.error) group.error = std::current_exception();
+			}
+		};
+
+		if (m_workers.empty())
+		{
+			for (size_t k = 0; k < numChunks; k++)
+			{
+				const auto range = StaticPartition(n, numChunks, k, blockSize);
+				if (range.begin < range.end) runChunk(k, range);
+			}
+		}
+		else
+		{
+			std::vector<ChunkRange> ranges(numChunks);
+			for (size_t k = 0; k < numChunks; k++)
+			{
+				ranges[k] = StaticPartition(n, numChunks, k, blockSize);
+				if (k > 0 && ranges[k].begin < ranges[k].end) group.remaining++;
+			}
+
+			for (size_t k = 1; k < numChunks; k++)
+			{
+				const auto range = ranges[k];
+				if (range.begin == range.end) continue;
+
+				auto& worker = *m_workers[(k - 1) % m_workers.size()];
+				std::lock_guard<std::mutex> lock(worker.mutex);
+				worker.tasks.emplace_back([this, &group, &runChunk, k, range]()
+				{
+					runChunk(k, range);
+					// the group lives on the stack of the waiting thread: do not touch it after the last decrement
+					if (group.remaining.fetch_sub(1) == 1) NotifyAll();
+				});
+				m_numPending++;
+			}
+			NotifyAll();
+
+			// the calling thread takes the first chunk, then helps until the whole group is done
+			if (ranges[0].begin < ranges[0].end) runChunk(0, ranges[0]);
+
+			while (group.remaining.load() > 0)
+			{
+				if (RunPendingTask()) continue;
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_signal.wait(lock, [this, &group]()
+				{
+					return group.remaining.load() == 0 || m_numPending.load() > 0;
+				});
+			}
+		}
+
+		if (group.error) std::rethrow_exception(group.error);
+	}
+
+	void ThreadPool::Run(size_t workerIdx)
+	{
+		currentPool = this;
+		currentWorkerIdx = workerIdx;
+
+		std::function<void()> task;
+		while (true)
+		{
+			if (PopTask(workerIdx, task) || StealTask(workerIdx, task))
+			{
+				task();
+				task = nullptr;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_signal.wait(lock, [this]()
+			{
+				return m_stop || m_numPending.load() > 0;
+			});
+			if (m_stop && m_numPending.load() == 0) return;
+		}
+	}
+
+	bool ThreadPool::PopTask(size_t workerIdx, std::function<void()>& task)
+	{
+		auto& worker = *m_workers[workerIdx];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.tasks.empty()) return false;
+		task = std::move(worker.tasks.back());
+		worker.tasks.pop_back();
+		m_numPending--;
+		return true;
+	}
+
+	bool ThreadPool::StealTask(size_t thiefIdx, std::function<void()>& task)
+	{
+		const size_t numWorkers = m_workers.size();
+		for (size_t i = 1; i <= numWorkers; i++)
+		{
+			const size_t victimIdx = (thiefIdx + i) % numWorkers;
+			if (victimIdx == thiefIdx) continue;
+
+			auto& victim = *m_workers[victimIdx];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.tasks.empty()) continue;
+			task = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			m_numPending--;
+			return true;
+		}
+		return false;
+	}
+
+	void ThreadPool::NotifyAll()
+	{
+		{
+			// taking the lock orders the notification after the waiters' predicate checks
+			std::lock_guard<std::mutex> lock(m_mutex);
+		}
+		m_signal.notify_all();
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SEPOLIA4::UTILITIES
+{
+	//===================================================================//
+	// Pool of persistent worker threads with one task deque per worker. //
+	// A worker pops its own tasks from the back (most recent first) and //
+	// when it runs out steals from the front of the other deques, so    //
+	// tasks submitted to a busy worker are picked up by an idle one.    //
+	// Threads waiting for their tasks help running pending tasks, which //
+	// makes nested parallel loops safe.                                 //
+	//===================================================================//
+
+	class ThreadPool final
+	{
+	public:
+
+		// pinned workers are bound to the CPUs 1, 2, ..., numWorkers (modulo the number of CPUs):
+		// the CPU 0 is left to the thread that submits the work
+		explicit ThreadPool(size_t numWorkers, bool pinThreads = false);
+
+		ThreadPool(const ThreadPool&) = delete;
+
+		ThreadPool(ThreadPool&&) = delete;
+
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		ThreadPool& operator=(ThreadPool&&) = delete;
+
+		// runs the pending tasks, then joins the workers
+		~ThreadPool();
+
+		[[nodiscard]] size_t GetNumWorkers() const;
+
+		[[nodiscard]] bool IsPinned() const;
+
+		// queues the task on the deque of the given worker (modulo the number of workers)
+		void Submit(size_t workerIdx, std::function<void()> task);
+
+		// runs one pending task on the calling thread, if any: false when there was none
+		bool RunPendingTask();
+
+		// runs body(chunkIdx, begin, end) on every non-empty chunk of StaticPartition(n, numChunks, chunkIdx, blockSize).
+		// The calling thread runs chunk 0 and chunk k is queued on worker k - 1, so repeated loops over
+		// the same data give each worker the same range. The first exception thrown by body is rethrown.
+		void ParallelFor(size_t n, size_t numChunks, size_t blockSize, const std::function<void(size_t, size_t, size_t)>& body);
+
+	private:
+
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+			std::thread thread;
+		};
+
+		void Run(size_t workerIdx);
+
+		bool PopTask(size_t workerIdx, std::function<void()>& task);
+
+		bool StealTask(size_t thiefIdx, std::function<void()>& task);
+
+		void NotifyAll();
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::atomic<size_t> m_numPending{ 0 };
+		std::mutex m_mutex;
+		std::condition_variable m_signal;
+		bool m_stop = false;
+		bool m_pinned = false;
+	};
+}